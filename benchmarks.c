@@ -0,0 +1,371 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/hal.h"
+#ifndef HAL_HOST
+#include "hardware/i2c.h"
+#include "pico/stdio_usb.h"
+#endif
+#include "inc/benchmark.h"
+#include "inc/ssd1306.h"
+#include "inc/decimator.h"
+#include "inc/frontend.h"
+#include "inc/vad.h"
+#include "inc/pitch_shift.h"
+#include "inc/resampler.h"
+#include "inc/effects.h"
+#include "inc/audio_store.h"
+#include "inc/fft.h"
+#include "inc/visualizer.h"
+#include "inc/voice.h"
+
+// Microbenchmarks dos kernels de áudio e das rotinas do display
+// O mesmo arquivo gera o executável do RP2040 (resultados pela USB, repetidos a cada tecla recebida)
+// e o do host (host/CMakeLists.txt); a saída são linhas JSON do benchmark_run
+
+#define I2C_SDA 14       // GPIO14 corresponde ao SDA do Display OLED da BitDogLab
+#define I2C_SCL 15       // GPIO15 corresponde ao SCL do Display OLED da BitDogLab
+#define I2C_PORT i2c1    // Corresponde ao I2C dos GPIO14 e GPIO15
+#define BLOCK 64         // Amostras por bloco, como na captura e na reprodução
+#define SAMPLE_RATE 12000
+#define PLAYBACK_RATE 16000
+#define KERNEL_ITERATIONS 256
+#define DISPLAY_ITERATIONS 64
+#define FLUSH_ITERATIONS 16
+#define STORE_SIZE 8192  // Bytes do audio_store dos benchmarks de ADPCM e da cadeia de voz
+
+// Sinal de teste: duas senoides e ruído, como uma voz perto do microfone
+static int16_t signal[4096];
+static uint16_t adc_input[BLOCK * DECIMATOR_FACTOR];
+static int16_t output[BLOCK];
+static uint16_t levels[BLOCK];
+static uint8_t store_memory[STORE_SIZE];
+static uint8_t ssd[ssd1306_buffer_length];
+static int16_t fft_re[FFT_SIZE];
+static int16_t fft_im[FFT_SIZE];
+
+static decimator_t bench_decimator;
+static frontend_t bench_frontend;
+static vad_t bench_vad;
+static pitch_shift_t bench_pitch;
+static resampler_t bench_resampler;
+static uint32_t signal_position = 0; // Próximo bloco de signal_block
+static uint32_t source_position = 0; // Próxima amostra de signal_source
+static uint32_t reads_left = 0;
+
+// Seno aproximado por duas parábolas, com amplitude 0,5 (Q15); basta para um sinal de teste
+static int16_t sine_q15(uint32_t phase)
+{
+    int32_t x = (int32_t)(phase >> 16) - 32768;
+    return (x * (65536 - 2 * (x < 0 ? -x : x))) >> 15;
+}
+
+static void signal_init(void)
+{
+    uint32_t random = 1;
+    uint32_t phase_a = 0, phase_b = 0;
+
+    for (uint32_t i = 0; i < count_of(signal); i++)
+    {
+        random = random * 1664525 + 1013904223;
+        phase_a += 0xFFFFFFFFu / SAMPLE_RATE * 220;
+        phase_b += 0xFFFFFFFFu / SAMPLE_RATE * 1370;
+        signal[i] = sine_q15(phase_a) / 3 + sine_q15(phase_b) / 8 + ((int32_t)(random >> 16) - 32768) / 64;
+    }
+    for (uint32_t i = 0; i < count_of(adc_input); i++)
+    {
+        adc_input[i] = 2048 + (signal[i] >> 4);
+    }
+}
+
+// Fonte do reamostrador: percorre o sinal de teste em círculo
+static uint32_t signal_source(int16_t *samples, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        samples[i] = signal[source_position++ & (count_of(signal) - 1)];
+    }
+    return count;
+}
+
+static const int16_t *signal_block(void)
+{
+    const int16_t *block = &signal[signal_position];
+    signal_position = (signal_position + BLOCK) & (count_of(signal) - 1);
+    return block;
+}
+
+// Kernels de áudio
+
+static void decimator_run(void)
+{
+    decimator_process(&bench_decimator, adc_input, count_of(adc_input), output);
+}
+
+static void frontend_run(void)
+{
+    frontend_process(&bench_frontend, signal_block(), output, BLOCK);
+}
+
+static void vad_run(void)
+{
+    vad_process(&bench_vad, signal_block(), BLOCK);
+}
+
+static void pitch_run(void)
+{
+    pitch_shift_process(&bench_pitch, signal_block(), output, BLOCK);
+}
+
+static void effects_setup(void)
+{
+    memcpy(output, signal_block(), sizeof(output)); // O efeito trabalha no lugar
+}
+
+static void effects_run(void)
+{
+    effects_process(output, BLOCK);
+}
+
+static void resampler_run(void)
+{
+    resampler_read(&bench_resampler, signal_source, output, BLOCK);
+}
+
+static void adpcm_encode_setup(void)
+{
+    if (audio_store_length() + BLOCK > audio_store_capacity(AUDIO_STORE_ADPCM))
+    {
+        audio_store_begin_write(AUDIO_STORE_ADPCM);
+    }
+}
+
+static void adpcm_encode_run(void)
+{
+    audio_store_write(signal_block(), BLOCK);
+}
+
+// Enche o audio_store com o sinal de teste em ADPCM, para os benchmarks que leem dele
+static void store_fill(void)
+{
+    audio_store_begin_write(AUDIO_STORE_ADPCM);
+    while (audio_store_write(signal_block(), BLOCK) == BLOCK)
+    {
+    }
+    audio_store_begin_read();
+    reads_left = audio_store_length() / BLOCK;
+}
+
+static void adpcm_decode_setup(void)
+{
+    if (reads_left-- == 0)
+    {
+        audio_store_begin_read();
+        reads_left = audio_store_length() / BLOCK - 1;
+    }
+}
+
+static void adpcm_decode_run(void)
+{
+    audio_store_read(output, BLOCK);
+}
+
+// Cadeia completa da reprodução: ADPCM -> reamostrador 12 -> 16 kHz -> tom -> efeitos -> níveis
+static void voice_setup(void)
+{
+    if (reads_left-- == 0)
+    {
+        audio_store_begin_read();
+        voice_set_source(SAMPLE_RATE, PLAYBACK_RATE);
+        reads_left = audio_store_length() / BLOCK - 1;
+    }
+}
+
+static void voice_run(void)
+{
+    voice_read_store(levels, BLOCK);
+}
+
+static void fft_setup(void)
+{
+    memcpy(fft_re, signal_block(), sizeof(fft_re));
+    memset(fft_im, 0, sizeof(fft_im));
+}
+
+static void fft_run(void)
+{
+    fft_window_q15(fft_re);
+    fft_q15(fft_re, fft_im);
+}
+
+// Display
+
+static void visualizer_spectrum_run(void)
+{
+    visualizer_render(ssd, ssd1306_page_height, ssd1306_height - ssd1306_page_height, VISUALIZER_SPECTRUM);
+}
+
+static void visualizer_waveform_run(void)
+{
+    visualizer_render(ssd, ssd1306_page_height, ssd1306_height - ssd1306_page_height, VISUALIZER_WAVEFORM);
+}
+
+static void draw_string_run(void)
+{
+    ssd1306_draw_string(ssd, 0, 8, "Tom      +4st   ", false);
+}
+
+static void draw_text_run(void)
+{
+    ssd1306_draw_text(ssd, 0, 0, "Gravando 12 kHz ADPCM", ssd1306_draw_set);
+}
+
+static void fill_rect_run(void)
+{
+    ssd1306_fill_rect(ssd, 0, 0, ssd1306_width, ssd1306_height, ssd1306_draw_xor);
+}
+
+// Tela do menu: limpa, 8 linhas de texto e a faixa invertida da linha selecionada
+static void menu_run(void)
+{
+    static const char *lines[] = {"Slot          1", "Tom      +4st", "Volume      30", "Veloc.     x1",
+                                  "Modo ao vivo", "Visual  Espectro", "Taxa grav. 12k", "Efeito     Eco"};
+    memset(ssd, 0, ssd1306_buffer_length);
+    for (uint32_t i = 0; i < count_of(lines); i++)
+    {
+        ssd1306_draw_string(ssd, 5, i * 8, (char *)lines[i], false);
+    }
+    ssd1306_fill_rect(ssd, 0, 16, ssd1306_width, 8, ssd1306_draw_xor);
+}
+
+// Envios: o setup espera o envio anterior terminar, para cada chamada medir um envio sozinho
+static void flush_full_setup(void)
+{
+    ssd1306_flush_wait();
+    ssd1306_invalidate();
+}
+
+static void flush_wait_setup(void)
+{
+    ssd1306_flush_wait();
+}
+
+static void flush_line_setup(void)
+{
+    ssd1306_flush_wait();
+    ssd1306_fill_rect(ssd, 0, 16, ssd1306_width, 8, ssd1306_draw_xor); // Troca a linha selecionada
+}
+
+static void flush_run(void)
+{
+    render_changes_on_display(ssd);
+}
+
+static void flush_async_run(void)
+{
+    render_changes_on_display_async(ssd, NULL);
+}
+
+static void render_area_run(void)
+{
+    struct render_area area = {0, ssd1306_width - 1, 0, ssd1306_n_pages - 1, 0};
+    calculate_render_area_buffer_length(&area);
+    render_on_display(ssd, &area);
+}
+
+static void run_all(const char *target)
+{
+    benchmark_begin(target);
+
+    decimator_init(&bench_decimator);
+    benchmark_run(&(benchmark_t){.name = "decimador", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .run = decimator_run});
+
+    frontend_init(&bench_frontend, SAMPLE_RATE);
+    benchmark_run(&(benchmark_t){.name = "entrada", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .run = frontend_run});
+
+    vad_init(&bench_vad, SAMPLE_RATE, BLOCK);
+    benchmark_run(&(benchmark_t){.name = "vad", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .run = vad_run});
+
+    pitch_shift_init(&bench_pitch);
+    pitch_shift_set_semitones(&bench_pitch, 4);
+    benchmark_run(&(benchmark_t){.name = "tom", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .run = pitch_run});
+
+    for (uint32_t i = 1; i < effects_chain_count(); i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "efeitos/%s", effects_chain_name(i));
+        effects_select(i, SAMPLE_RATE);
+        benchmark_run(&(benchmark_t){.name = name, .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .setup = effects_setup, .run = effects_run});
+    }
+
+    resampler_init(&bench_resampler, SAMPLE_RATE, PLAYBACK_RATE);
+    benchmark_run(&(benchmark_t){.name = "reamostrador", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .run = resampler_run});
+
+    audio_store_init(store_memory, STORE_SIZE);
+    audio_store_begin_write(AUDIO_STORE_ADPCM);
+    benchmark_run(&(benchmark_t){.name = "adpcm/codificar", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .setup = adpcm_encode_setup, .run = adpcm_encode_run});
+
+    store_fill();
+    benchmark_run(&(benchmark_t){.name = "adpcm/decodificar", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .setup = adpcm_decode_setup, .run = adpcm_decode_run});
+
+    store_fill();
+    voice_set_source(SAMPLE_RATE, PLAYBACK_RATE);
+    voice_reset(4, 1, 0, PLAYBACK_RATE);
+    benchmark_run(&(benchmark_t){.name = "voz/reproducao", .unit = "amostra", .items = BLOCK, .iterations = KERNEL_ITERATIONS, .setup = voice_setup, .run = voice_run});
+
+    benchmark_run(&(benchmark_t){.name = "fft", .unit = "quadro", .items = 1, .iterations = KERNEL_ITERATIONS, .setup = fft_setup, .run = fft_run});
+
+    visualizer_reset();
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        visualizer_feed(signal_block(), BLOCK);
+    }
+    benchmark_run(&(benchmark_t){.name = "visual/espectro", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = visualizer_spectrum_run});
+    benchmark_run(&(benchmark_t){.name = "visual/onda", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = visualizer_waveform_run});
+
+    benchmark_run(&(benchmark_t){.name = "display/draw_string", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = draw_string_run});
+    benchmark_run(&(benchmark_t){.name = "display/draw_text", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = draw_text_run});
+    benchmark_run(&(benchmark_t){.name = "display/fill_rect", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = fill_rect_run});
+    benchmark_run(&(benchmark_t){.name = "display/menu", .unit = "quadro", .items = 1, .iterations = DISPLAY_ITERATIONS, .run = menu_run});
+
+    // Envios pelo barramento (no host, pelo substituto, que conta os mesmos bytes)
+    benchmark_run(&(benchmark_t){.name = "envio/completo", .unit = "quadro", .items = 1, .iterations = FLUSH_ITERATIONS, .setup = flush_full_setup, .run = flush_run, .bus_bytes = ssd1306_bus_bytes});
+    benchmark_run(&(benchmark_t){.name = "envio/completo_cpu", .unit = "quadro", .items = 1, .iterations = FLUSH_ITERATIONS, .setup = flush_full_setup, .run = flush_async_run, .bus_bytes = ssd1306_bus_bytes});
+    benchmark_run(&(benchmark_t){.name = "envio/uma_linha", .unit = "quadro", .items = 1, .iterations = FLUSH_ITERATIONS, .setup = flush_line_setup, .run = flush_run, .bus_bytes = ssd1306_bus_bytes});
+    benchmark_run(&(benchmark_t){.name = "envio/sem_mudancas", .unit = "quadro", .items = 1, .iterations = FLUSH_ITERATIONS, .setup = flush_wait_setup, .run = flush_run, .bus_bytes = ssd1306_bus_bytes});
+    benchmark_run(&(benchmark_t){.name = "envio/render_on_display", .unit = "quadro", .items = 1, .iterations = FLUSH_ITERATIONS, .setup = flush_full_setup, .run = render_area_run, .bus_bytes = ssd1306_bus_bytes});
+    ssd1306_flush_wait();
+
+    benchmark_end();
+}
+
+int main()
+{
+#ifdef HAL_HOST
+    signal_init();
+    ssd1306_init();
+    run_all("host");
+#else
+    stdio_init_all();
+
+    i2c_init(I2C_PORT, ssd1306_i2c_clock * 1000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+    ssd1306_init();
+
+    signal_init();
+    while (true)
+    {
+        // Espera o terminal USB abrir (ou qualquer tecla) e roda tudo de novo
+        while (getchar_timeout_us(100000) == PICO_ERROR_TIMEOUT && !stdio_usb_connected())
+        {
+        }
+        run_all("rp2040");
+        while (getchar_timeout_us(1000000) == PICO_ERROR_TIMEOUT)
+        {
+        }
+    }
+#endif
+    return 0;
+}
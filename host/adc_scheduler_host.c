@@ -0,0 +1,87 @@
+#include "adc_scheduler.h"
+#include "host.h"
+
+#define ADC_HOST_CHANNELS 5 // Canais 0 a 4, como no RP2040
+#define ADC_HOST_MIDSCALE 2048
+
+static uint32_t adc_sample_rate = 12000;
+static adc_channel_handler_t adc_handlers[ADC_HOST_CHANNELS];
+
+// Fonte do canal de áudio e conversão da taxa dela para a taxa das conversões do ADC
+static resampler_source_t adc_source = NULL;
+static uint adc_source_channel = 0;
+static uint32_t adc_source_rate = 0;
+static resampler_t adc_resampler;
+static bool adc_resampler_ready = false;
+
+static int16_t adc_input[ADC_SCHEDULER_FRAMES];
+static uint16_t adc_block[ADC_SCHEDULER_FRAMES];
+
+void adc_scheduler_init(uint32_t sample_rate)
+{
+    adc_scheduler_set_sample_rate(sample_rate);
+}
+
+void adc_scheduler_set_sample_rate(uint32_t sample_rate)
+{
+    adc_sample_rate = sample_rate > ADC_SCHEDULER_MAX_RATE ? ADC_SCHEDULER_MAX_RATE : sample_rate;
+    adc_resampler_ready = false;
+}
+
+uint32_t adc_scheduler_get_sample_rate(void)
+{
+    return adc_sample_rate;
+}
+
+void adc_scheduler_set_handler(uint channel, adc_channel_handler_t handler)
+{
+    if (channel < ADC_HOST_CHANNELS)
+    {
+        adc_handlers[channel] = handler;
+    }
+}
+
+void adc_scheduler_start(void)
+{
+}
+
+void adc_scheduler_host_set_source(uint channel, resampler_source_t source, uint32_t source_rate)
+{
+    adc_source = source;
+    adc_source_channel = channel;
+    adc_source_rate = source_rate;
+    adc_resampler_ready = false;
+}
+
+// Entrega um bloco do rodízio a cada handler, como a IRQ do DMA faria
+// O áudio passa pelo mesmo caminho do firmware: 12 bits em torno do meio da escala, sobreamostrado
+// ADC_SCHEDULER_OVERSAMPLE vezes; retorna false quando a fonte acaba (o resto do bloco é silêncio)
+bool adc_scheduler_host_step(void)
+{
+    uint32_t n = 0;
+
+    if (adc_source)
+    {
+        if (!adc_resampler_ready)
+        {
+            resampler_init(&adc_resampler, adc_source_rate, adc_sample_rate * ADC_SCHEDULER_OVERSAMPLE);
+            adc_resampler_ready = true;
+        }
+        n = resampler_read(&adc_resampler, adc_source, adc_input, ADC_SCHEDULER_FRAMES);
+    }
+
+    for (uint channel = 0; channel < ADC_HOST_CHANNELS; channel++)
+    {
+        if (!adc_handlers[channel])
+        {
+            continue;
+        }
+        for (uint i = 0; i < ADC_SCHEDULER_FRAMES; i++)
+        {
+            bool audio = adc_source && channel == adc_source_channel && i < n;
+            adc_block[i] = audio ? ADC_HOST_MIDSCALE + (adc_input[i] >> 4) : ADC_HOST_MIDSCALE;
+        }
+        adc_handlers[channel](adc_block, ADC_SCHEDULER_FRAMES);
+    }
+    return n == ADC_SCHEDULER_FRAMES;
+}
@@ -0,0 +1,90 @@
+#include "audio_playback.h"
+#include "stats.h"
+#include "audio_stream.h"
+#include "host.h"
+
+static playback_fill_handler_t playback_fill = NULL;
+static playback_done_handler_t playback_done = NULL;
+static bool playback_running = false;
+static wav_file_t *playback_output = NULL;
+static uint16_t playback_levels[PLAYBACK_BLOCK_SIZE];
+
+void audio_playback_init(uint gpio_a, uint gpio_b)
+{
+    (void)gpio_a;
+    (void)gpio_b;
+}
+
+bool audio_playback_start(uint32_t sample_rate, playback_fill_handler_t fill, playback_done_handler_t done)
+{
+    (void)sample_rate; // A taxa do arquivo de saída é escolhida por quem o abriu
+    if (playback_running)
+    {
+        return false;
+    }
+    playback_fill = fill;
+    playback_done = done;
+    playback_running = true;
+    return true;
+}
+
+void audio_playback_stop(void)
+{
+    playback_running = false;
+}
+
+bool audio_playback_is_running(void)
+{
+    return playback_running;
+}
+
+void audio_playback_host_set_output(wav_file_t *wav)
+{
+    playback_output = wav;
+}
+
+// Grava níveis da reprodução (0 a PLAYBACK_LEVEL_MAX) no WAV de saída como amostras Q15
+// No firmware eles ainda passam pelo PWM de 8 bits com noise shaping; aqui saem com os 16 bits
+void audio_playback_host_write_levels(const uint16_t *levels, uint count)
+{
+    int16_t samples[PLAYBACK_BLOCK_SIZE];
+
+    if (playback_output)
+    {
+        audio_stream_levels(levels, count, playback_output->rate);
+    }
+    while (count > 0 && playback_output)
+    {
+        uint n = count < PLAYBACK_BLOCK_SIZE ? count : PLAYBACK_BLOCK_SIZE;
+        for (uint i = 0; i < n; i++)
+        {
+            samples[i] = (int32_t)levels[i] - (PLAYBACK_LEVEL_MAX / 2 + 1);
+        }
+        wav_write(playback_output, samples, n);
+        levels += n;
+        count -= n;
+    }
+}
+
+// Pede um bloco ao fill, como a IRQ do DMA na troca de metade; retorna false quando a reprodução acaba
+bool audio_playback_host_step(void)
+{
+    if (!playback_running)
+    {
+        return false;
+    }
+
+    uint32_t start = stats_begin();
+    uint count = playback_fill ? playback_fill(playback_levels, PLAYBACK_BLOCK_SIZE) : 0;
+    stats_end(STATS_PLAYBACK_FILL, start);
+    audio_playback_host_write_levels(playback_levels, count);
+    if (count < PLAYBACK_BLOCK_SIZE)
+    {
+        playback_running = false;
+        if (playback_done)
+        {
+            playback_done();
+        }
+    }
+    return playback_running;
+}
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <string.h>
+#include "flash_store.h"
+#include "host.h"
+
+// Verificação da flash_store contra a flash em RAM do host (flash_store_host.c):
+// montagem, gravações que cruzam setores, compactação do índice, evicção pela janela apagada,
+// volta do log ao início e remontagem depois de um registro do índice gravado pela metade
+// Sai com erro se alguma verificação falhar
+
+#define CHECK_DATA_SECTORS 8
+#define CHECK_REGION_SIZE ((FLASH_STORE_INDEX_SECTORS + CHECK_DATA_SECTORS) * FLASH_STORE_SECTOR_SIZE)
+#define CHECK_MAX_BYTES (2 * FLASH_STORE_SECTOR_SIZE) // Maior gravação (janela apagada à frente)
+#define CHECK_MAGIC 0xA55B                            // FLASH_STORE_MAGIC
+
+// O que cada slot deveria conter
+typedef struct
+{
+    uint32_t seed; // 0 = vazio
+    uint32_t bytes;
+} check_slot_t;
+
+static check_slot_t expected[FLASH_STORE_SLOTS];
+static const flash_store_ops_t *ops;
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+static uint32_t record_tear_bytes = 0; // Corta a gravação do registro no finish da próxima gravação
+
+static bool check(bool condition, const char *what)
+{
+    checks++;
+    if (!condition)
+    {
+        printf("FALHA: %s\n", what);
+        failures++;
+    }
+    return condition;
+}
+
+static uint8_t pattern(uint32_t seed, uint32_t i)
+{
+    return (uint8_t)(seed * 131 + i * 7 + (i >> 8));
+}
+
+// Grava bytes no slot em pedaços de tamanhos variados, como os blocos do audio_store
+static bool record(uint8_t slot, uint32_t seed, uint32_t bytes)
+{
+    static const uint32_t chunks[] = {1, 37, 300, 1000, 256};
+    uint8_t data[1000];
+
+    while (flash_store_service())
+    {
+    }
+    if (!flash_store_begin(slot, seed & 1, 8000 + slot))
+    {
+        return false;
+    }
+    for (uint32_t done = 0, k = 0; done < bytes; k++)
+    {
+        uint32_t n = chunks[k % count_of(chunks)];
+        n = n < bytes - done ? n : bytes - done;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            data[i] = pattern(seed, done + i);
+        }
+        flash_store_write(data, n);
+        done += n;
+    }
+    if (record_tear_bytes)
+    {
+        flash_store_host_tear_next_program(record_tear_bytes);
+        record_tear_bytes = 0;
+    }
+    flash_store_finish(2 * bytes, bytes);
+    expected[slot].seed = seed;
+    expected[slot].bytes = bytes;
+    return true;
+}
+
+static bool slot_matches(uint8_t slot)
+{
+    const uint8_t *data = flash_store_slot_data(slot);
+    if (!data || flash_store_slot_length(slot) != 2 * expected[slot].bytes ||
+        flash_store_slot_rate(slot) != 8000u + slot || flash_store_slot_format(slot) != (expected[slot].seed & 1))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < expected[slot].bytes; i++)
+    {
+        if (data[i] != pattern(expected[slot].seed, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Confere os slots: um slot presente tem que ter exatamente o que foi gravado nele
+// Um slot que sumiu foi despejado pela janela apagada; retorna quantos sumiram agora
+static uint32_t verify_slots(void)
+{
+    uint32_t evicted = 0;
+    for (uint8_t slot = 0; slot < FLASH_STORE_SLOTS; slot++)
+    {
+        if (flash_store_slot_length(slot) == 0)
+        {
+            if (expected[slot].seed)
+            {
+                expected[slot].seed = 0;
+                evicted++;
+            }
+            continue;
+        }
+        check(expected[slot].seed != 0, "slot vazio reapareceu com dados");
+        check(slot_matches(slot), "dados do slot diferem do gravado");
+    }
+    return evicted;
+}
+
+// Setor do índice com o registro de maior sequência (só pelo conteúdo da flash)
+static uint32_t index_sector_in_use(void)
+{
+    uint32_t best_sector = 0, best_sequence = 0;
+    for (uint32_t sector = 0; sector < FLASH_STORE_INDEX_SECTORS; sector++)
+    {
+        const flash_store_record_t *records = (const flash_store_record_t *)(ops->base + sector * FLASH_STORE_SECTOR_SIZE);
+        for (uint32_t i = 0; i < FLASH_STORE_SECTOR_SIZE / sizeof(flash_store_record_t); i++)
+        {
+            if (records[i].magic == CHECK_MAGIC && records[i].sequence > best_sequence)
+            {
+                best_sequence = records[i].sequence;
+                best_sector = sector;
+            }
+        }
+    }
+    return best_sector;
+}
+
+static void check_mount(void)
+{
+    ops = flash_store_host_ops(CHECK_REGION_SIZE);
+    memset(expected, 0, sizeof(expected));
+    check(flash_store_mount(ops, CHECK_MAX_BYTES), "montagem da flash apagada");
+    check(verify_slots() == 0, "flash apagada com slots");
+    check(flash_store_host_erases() == 0, "setores ja apagados foram apagados de novo");
+
+    // Lixo no índice, sem nenhum registro válido: o setor é apagado na montagem
+    memset(flash_store_host_memory(), 0x12, 100);
+    check(flash_store_mount(ops, CHECK_MAX_BYTES), "montagem com lixo no indice");
+    check(verify_slots() == 0, "lixo no indice virou slot");
+    check(flash_store_host_memory()[0] == 0xFF, "lixo no indice nao foi apagado");
+
+    check(!flash_store_mount(ops, CHECK_REGION_SIZE), "janela maior que a regiao aceita");
+}
+
+static void check_cross_sector(void)
+{
+    ops = flash_store_host_ops(CHECK_REGION_SIZE);
+    memset(expected, 0, sizeof(expected));
+    flash_store_mount(ops, CHECK_MAX_BYTES);
+
+    check(record(0, 1, FLASH_STORE_SECTOR_SIZE + 904), "gravacao cruzando setor");
+    check(flash_store_slot_data(0) == ops->base + FLASH_STORE_INDEX_SECTORS * FLASH_STORE_SECTOR_SIZE,
+          "primeira gravacao fora do inicio do log");
+    check(slot_matches(0), "dados cruzando setor");
+    check(record(1, 2, 300), "gravacao curta depois da longa");
+    check(flash_store_slot_data(1) == flash_store_slot_data(0) + 2 * FLASH_STORE_SECTOR_SIZE,
+          "gravacao seguinte nao comeca no proximo setor livre");
+
+    // Gravação maior que a janela: guarda só as páginas que couberam
+    while (flash_store_service())
+    {
+    }
+    check(flash_store_begin(2, 0, 8002), "inicio da gravacao longa");
+    uint8_t page[FLASH_STORE_PAGE_SIZE];
+    memset(page, 0x33, sizeof(page));
+    for (uint32_t i = 0; i < CHECK_MAX_BYTES / FLASH_STORE_PAGE_SIZE + 4; i++)
+    {
+        flash_store_write(page, sizeof(page));
+    }
+    flash_store_finish(CHECK_MAX_BYTES + 4 * FLASH_STORE_PAGE_SIZE, CHECK_MAX_BYTES + 4 * FLASH_STORE_PAGE_SIZE);
+    check(flash_store_slot_length(2) == CHECK_MAX_BYTES, "gravacao longa nao foi truncada na janela");
+
+    check(flash_store_mount(ops, CHECK_MAX_BYTES), "remontagem");
+    expected[2].seed = 0;
+    check(slot_matches(0) && slot_matches(1), "dados depois da remontagem");
+    check(flash_store_slot_length(2) == CHECK_MAX_BYTES, "gravacao truncada depois da remontagem");
+    check(flash_store_host_violations() == 0, "gravacao em bits nao apagados");
+}
+
+// Muitas gravações seguidas: o log dá voltas, a janela despeja os slots mais antigos e o índice
+// enche e é compactado no outro setor, várias vezes
+static void check_log_cycle(void)
+{
+    ops = flash_store_host_ops(CHECK_REGION_SIZE);
+    memset(expected, 0, sizeof(expected));
+    flash_store_mount(ops, CHECK_MAX_BYTES);
+
+    uint32_t evictions = 0, wraps = 0, index_switches = 0;
+    uint32_t index_sector = index_sector_in_use();
+    const uint8_t *previous = NULL;
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        uint8_t slot = (i * 7 / 3) % FLASH_STORE_SLOTS; // Às vezes o mesmo slot duas vezes seguidas
+        uint32_t bytes = 1 + (i * 2654435761u) % CHECK_MAX_BYTES;
+        if (!check(record(slot, i + 10, bytes), "gravacao no ciclo do log"))
+        {
+            break;
+        }
+        check(slot_matches(slot), "gravacao mais recente despejada");
+
+        const uint8_t *data = flash_store_slot_data(slot);
+        wraps += previous && data < previous;
+        previous = data;
+
+        // Com o áudio parado o firmware completa a janela apagada, despejando o que estiver nela
+        while (flash_store_service())
+        {
+        }
+        evictions += verify_slots();
+
+        uint32_t sector = index_sector_in_use();
+        index_switches += sector != index_sector;
+        index_sector = sector;
+
+        // Remontar a qualquer momento tem que achar exatamente os mesmos slots e a mesma cabeça
+        check(flash_store_mount(ops, CHECK_MAX_BYTES), "remontagem no ciclo do log");
+        check(verify_slots() == 0, "slot perdido na remontagem");
+    }
+    check(wraps > 0, "o log nunca voltou ao inicio");
+    check(evictions > 0, "nenhum slot foi despejado pela janela apagada");
+    check(index_switches >= 2, "o indice nao foi compactado nos dois setores");
+    check(flash_store_host_violations() == 0, "gravacao em bits nao apagados");
+    printf("ciclo do log: voltas=%u despejos=%u compactacoes=%u apagamentos=%u paginas=%u\n",
+           (unsigned)wraps, (unsigned)evictions, (unsigned)index_switches,
+           (unsigned)flash_store_host_erases(), (unsigned)flash_store_host_programs());
+}
+
+// Queda de energia no meio do registro do índice: a remontagem ignora o registro rasgado, o slot
+// volta à gravação anterior e os próximos registros vão depois dele
+static void check_torn_record(uint32_t tear_bytes)
+{
+    ops = flash_store_host_ops(CHECK_REGION_SIZE);
+    memset(expected, 0, sizeof(expected));
+    flash_store_mount(ops, CHECK_MAX_BYTES);
+
+    record(2, 3, FLASH_STORE_SECTOR_SIZE);
+    record(1, 4, 1000);
+    check_slot_t before = expected[2];
+
+    // Tamanho múltiplo da página: a única gravação do finish é a do registro
+    record_tear_bytes = tear_bytes;
+    record(2, 5, 2 * FLASH_STORE_PAGE_SIZE);
+
+    check(flash_store_mount(ops, CHECK_MAX_BYTES), "remontagem depois do registro rasgado");
+    expected[2] = before;
+    check(slot_matches(2), "slot do registro rasgado nao voltou a gravacao anterior");
+    check(slot_matches(1), "outro slot afetado pelo registro rasgado");
+
+    check(record(3, 6, 3000), "gravacao depois do registro rasgado");
+    check(flash_store_mount(ops, CHECK_MAX_BYTES), "segunda remontagem");
+    check(verify_slots() == 0 && slot_matches(1) && slot_matches(2) && slot_matches(3),
+          "slots depois da segunda remontagem");
+    check(flash_store_host_violations() == 0, "registro novo gravado sobre o rasgado");
+}
+
+int main(void)
+{
+    check_mount();
+    check_cross_sector();
+    check_log_cycle();
+    check_torn_record(1);
+    check_torn_record(12);
+    check_torn_record(sizeof(flash_store_record_t) - 1);
+
+    printf("flash_store: verificacoes=%u falhas=%u\n", (unsigned)checks, (unsigned)failures);
+    return failures ? 1 : 0;
+}
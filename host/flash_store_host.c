@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+
+// Substituto da flash QSPI: um vetor em RAM com as mesmas regras do hardware
+//   apagar: setores inteiros, alinhados, viram 0xFF
+//   programar: páginas inteiras, alinhadas, que só levam bits de 1 para 0 (AND com o conteúdo)
+// Bytes 0xFF na página não alteram nada (é assim que a flash_store grava trechos menores que a página);
+// um byte que não fica igual ao pedido caiu sobre bits já gravados e é contado como violação
+static uint8_t *flash_memory = NULL;
+static flash_store_ops_t flash_host_ops;
+static uint32_t flash_violations = 0;
+static uint32_t flash_erases = 0;
+static uint32_t flash_programs = 0;
+static uint32_t flash_tear_bytes = 0; // 0 = próxima gravação completa
+
+static void flash_store_host_erase_sector(uint32_t offset)
+{
+    if (offset % FLASH_STORE_SECTOR_SIZE || offset + FLASH_STORE_SECTOR_SIZE > flash_host_ops.size)
+    {
+        fprintf(stderr, "flash: apagamento fora de setor em 0x%x\n", (unsigned)offset);
+        flash_violations++;
+        return;
+    }
+    memset(flash_memory + offset, 0xFF, FLASH_STORE_SECTOR_SIZE);
+    flash_erases++;
+}
+
+static void flash_store_host_program_page(uint32_t offset, const uint8_t *data)
+{
+    if (offset % FLASH_STORE_PAGE_SIZE || offset + FLASH_STORE_PAGE_SIZE > flash_host_ops.size)
+    {
+        fprintf(stderr, "flash: gravacao fora de pagina em 0x%x\n", (unsigned)offset);
+        flash_violations++;
+        return;
+    }
+
+    uint8_t *page = flash_memory + offset;
+    uint32_t end = FLASH_STORE_PAGE_SIZE;
+    if (flash_tear_bytes)
+    {
+        // Queda de energia: a gravação para flash_tear_bytes depois do primeiro byte que ela mudaria
+        for (uint32_t i = 0; i < FLASH_STORE_PAGE_SIZE; i++)
+        {
+            if ((page[i] & data[i]) != page[i])
+            {
+                end = i + flash_tear_bytes < FLASH_STORE_PAGE_SIZE ? i + flash_tear_bytes : FLASH_STORE_PAGE_SIZE;
+                break;
+            }
+        }
+        flash_tear_bytes = 0;
+    }
+
+    for (uint32_t i = 0; i < end; i++)
+    {
+        page[i] &= data[i];
+        if (data[i] != 0xFF && page[i] != data[i])
+        {
+            flash_violations++;
+        }
+    }
+    flash_programs++;
+}
+
+// Cria (ou recria) a flash em RAM com size bytes, toda apagada
+const flash_store_ops_t *flash_store_host_ops(uint32_t size)
+{
+    free(flash_memory);
+    flash_memory = malloc(size);
+    memset(flash_memory, 0xFF, size);
+    flash_violations = flash_erases = flash_programs = flash_tear_bytes = 0;
+
+    flash_host_ops.erase_sector = flash_store_host_erase_sector;
+    flash_host_ops.program_page = flash_store_host_program_page;
+    flash_host_ops.base = flash_memory;
+    flash_host_ops.size = size;
+    return &flash_host_ops;
+}
+
+// Acesso direto ao conteúdo, para preparar lixo ou conferir o que foi gravado
+uint8_t *flash_store_host_memory(void)
+{
+    return flash_memory;
+}
+
+void flash_store_host_tear_next_program(uint32_t bytes)
+{
+    flash_tear_bytes = bytes;
+}
+
+uint32_t flash_store_host_violations(void)
+{
+    return flash_violations;
+}
+
+uint32_t flash_store_host_erases(void)
+{
+    return flash_erases;
+}
+
+uint32_t flash_store_host_programs(void)
+{
+    return flash_programs;
+}
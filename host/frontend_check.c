@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "frontend.h"
+#include "host.h"
+
+// Verificação da etapa de entrada (frontend_process) com um tom de 400 Hz a 12 kHz:
+// o DC some, o ganho do AGC se acomoda dentro da antecipação num degrau de volume (sem estourar)
+// e o portão leva o ganho a zero no silêncio
+// Sai com erro se alguma verificação falhar
+
+#define CHECK_RATE 12000
+#define CHECK_TONE_PERIOD 30 // 400 Hz a 12 kHz
+#define CHECK_DC 3000
+#define CHECK_TOLERANCE 1024 // Folga em torno do pico desejado (~0,5 dB)
+
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+static bool check(bool condition, const char *what)
+{
+    checks++;
+    if (!condition)
+    {
+        printf("FALHA: %s\n", what);
+        failures++;
+    }
+    return condition;
+}
+
+// Tom triangular de 400 Hz (sem trigonometria) com pico amplitude, mais o DC
+static int16_t tone(uint32_t n, int32_t amplitude, int32_t dc)
+{
+    int32_t phase = n % CHECK_TONE_PERIOD;
+    int32_t half = CHECK_TONE_PERIOD / 2;
+    int32_t ramp = phase < half ? 2 * phase - half : 3 * half - 2 * phase; // -half a +half
+    int32_t value = dc + amplitude * ramp / half;
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value);
+}
+
+// Processa count amostras uma a uma; devolve o pico e a média da saída
+static void run(frontend_t *fe, uint32_t *n, uint32_t count, int32_t amplitude, int32_t dc,
+                int32_t *peak, int32_t *mean)
+{
+    int64_t sum = 0;
+    *peak = 0;
+    for (uint32_t i = 0; i < count; i++, (*n)++)
+    {
+        int16_t x = tone(*n, amplitude, dc);
+        int16_t y;
+        frontend_process(fe, &x, &y, 1);
+        sum += y;
+        if (abs(y) > *peak)
+        {
+            *peak = abs(y);
+        }
+    }
+    *mean = (int32_t)(sum / (int64_t)count);
+}
+
+static void check_dc(void)
+{
+    frontend_t fe;
+    uint32_t n = 0;
+    int32_t peak, mean;
+
+    frontend_init(&fe, CHECK_RATE);
+    run(&fe, &n, CHECK_RATE, 4000, CHECK_DC, &peak, &mean); // 1 s: o passa-altas (~7 Hz) já se acomodou
+    run(&fe, &n, 30 * CHECK_TONE_PERIOD, 4000, CHECK_DC, &peak, &mean);
+    printf("dc: entrada=%d media=%d pico=%d\n", CHECK_DC, (int)mean, (int)peak);
+    check(abs(mean) < 64, "o DC nao foi removido");
+    check(abs(peak - FRONTEND_TARGET) < CHECK_TOLERANCE, "o AGC nao levou o tom ao pico desejado");
+}
+
+// Degrau de 1000 para 20000 de pico: o envelope vê o degrau FRONTEND_LOOKAHEAD amostras antes da saída,
+// então o ganho já está no valor final quando o pico sai da linha de atraso
+static void check_agc_step(void)
+{
+    frontend_t fe;
+    uint32_t n = 0;
+    int32_t peak, mean;
+
+    frontend_init(&fe, CHECK_RATE);
+    run(&fe, &n, CHECK_RATE, 1000, 0, &peak, &mean);
+    check(abs(peak - FRONTEND_TARGET) < CHECK_TOLERANCE, "o AGC nao levou o tom baixo ao pico desejado");
+
+    // Ganho final do tom alto, medido numa cópia que já estava nele
+    frontend_t settled = fe;
+    uint32_t m = n;
+    run(&settled, &m, CHECK_RATE, 20000, 0, &peak, &mean);
+    int32_t final_gain = settled.gain;
+
+    uint32_t onset = n;
+    run(&fe, &n, FRONTEND_LOOKAHEAD, 20000, 0, &peak, &mean);
+    printf("agc: ganho no fim da antecipacao=%d final=%d\n", (int)fe.gain, (int)final_gain);
+    check(abs(fe.gain - final_gain) <= final_gain / 16, "o ganho nao se acomodou dentro da antecipacao");
+
+    run(&fe, &n, CHECK_RATE - (n - onset), 20000, 0, &peak, &mean);
+    printf("agc: pico depois do degrau=%d\n", (int)peak);
+    check(peak < FRONTEND_TARGET + CHECK_TOLERANCE, "o degrau estourou a saida");
+}
+
+static void check_gate(void)
+{
+    frontend_t fe;
+    uint32_t n = 0;
+    int32_t peak, mean;
+
+    frontend_init(&fe, CHECK_RATE);
+    run(&fe, &n, CHECK_RATE, 4000, 0, &peak, &mean);
+    check(fe.gate_open, "o portao nao abriu com o tom");
+
+    run(&fe, &n, 2 * CHECK_RATE, 0, 0, &peak, &mean);
+    printf("portao: ganho depois de 2 s de silencio=%d\n", (int)fe.gain);
+    check(!fe.gate_open, "o portao nao fechou no silencio");
+    check(fe.gain == 0, "o ganho nao chegou a zero no silencio");
+
+    // Ruído baixo (abaixo do limiar) com o portão fechado continua em zero
+    run(&fe, &n, CHECK_RATE, FRONTEND_GATE_CLOSE / 2, 0, &peak, &mean);
+    check(peak == 0, "ruido abaixo do limiar passou pelo portao fechado");
+}
+
+int main(void)
+{
+    check_dc();
+    check_agc_step();
+    check_gate();
+
+    printf("frontend: verificacoes=%u falhas=%u\n", (unsigned)checks, (unsigned)failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+#include <time.h>
+#include "hal.h"
+
+// No host tudo roda numa só thread: não há interrupções para mascarar nem para esperar
+
+uint32_t hal_irq_disable(void)
+{
+    return 0;
+}
+
+void hal_irq_restore(uint32_t state)
+{
+    (void)state;
+}
+
+void hal_wait_for_interrupt(void)
+{
+}
+
+void hal_memory_barrier(void)
+{
+    __sync_synchronize();
+}
+
+void hal_cycles_init(void)
+{
+}
+
+uint32_t hal_cycles(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000u + now.tv_nsec);
+}
+
+uint32_t hal_cycles_hz(void)
+{
+    return 1000000000u;
+}
+
+uint32_t hal_time_us(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000u + now.tv_nsec / 1000);
+}
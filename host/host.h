@@ -0,0 +1,36 @@
+#include "hal.h"
+#include "resampler.h"
+#include "wav.h"
+#include "flash_store.h"
+
+#ifndef host_inc_h
+#define host_inc_h
+
+// Controles dos substitutos do hardware no build do host
+// No firmware as IRQs do DMA chamam os handlers no ritmo do relógio; aqui quem chama é o simulador,
+// um bloco por vez e o mais rápido possível
+
+// ADC: o canal escolhido recebe o áudio de source (Q15 em source_rate), sobreamostrado para a taxa
+// do rodízio; os outros canais ficam no meio da escala (Joystick solto)
+extern void adc_scheduler_host_set_source(uint channel, resampler_source_t source, uint32_t source_rate);
+extern bool adc_scheduler_host_step(void);
+
+// Reprodução: os níveis viram amostras Q15 no WAV de saída
+extern void audio_playback_host_set_output(wav_file_t *wav);
+extern bool audio_playback_host_step(void);
+extern void audio_playback_host_write_levels(const uint16_t *levels, uint count);
+
+// Display: cada envio vira um quadro PGM em frame_dir (NULL desliga)
+extern void ssd1306_host_set_frame_dir(const char *frame_dir);
+extern uint32_t ssd1306_host_frames(void);
+
+// Flash: vetor em RAM com apagamento por setor (0xFF) e gravação por página (só 1 -> 0)
+// tear_next_program corta a próxima gravação no meio, como uma queda de energia
+extern const flash_store_ops_t *flash_store_host_ops(uint32_t size);
+extern uint8_t *flash_store_host_memory(void);
+extern void flash_store_host_tear_next_program(uint32_t bytes);
+extern uint32_t flash_store_host_violations(void);
+extern uint32_t flash_store_host_erases(void);
+extern uint32_t flash_store_host_programs(void);
+
+#endif
@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "audio_capture.h"
+#include "audio_playback.h"
+#include "audio_store.h"
+#include "effects.h"
+#include "pitch_shift.h"
+#include "visualizer.h"
+#include "voice.h"
+#include "ssd1306.h"
+#include "stats.h"
+#include "audio_stream.h"
+#include "host.h"
+
+// Simulador do host: roda a mesma cadeia do firmware sobre arquivos WAV, sem relógio de tempo real
+//   gravar + tocar (padrão): WAV -> ADC (12 bits, sobreamostrado) -> dizimador -> entrada -> audio_store
+//                            -> reamostrador -> tom -> efeitos -> WAV
+//   ao vivo (-L):            WAV -> ADC -> dizimador -> entrada -> tom -> efeitos -> WAV, na taxa de captura
+// Com -d os quadros do display viram arquivos PGM; com -c a saída é comparada a uma referência
+// Com -U os quadros do streaming (captura e saída) vão para um arquivo, no lugar da USB: o
+// stream_receiver o transforma de volta em WAV, fechando o laço do protocolo sem a placa
+
+#define MIC_CHANNEL 2 // Mesmo canal do microfone da BitDogLab
+
+static wav_file_t input_wav;
+static wav_file_t output_wav;
+static uint8_t *record_memory = NULL;
+static audio_store_format_t record_format = AUDIO_STORE_ADPCM;
+
+// Display e visualização, no ritmo de VISUALIZER_FRAME_MS do tempo do áudio
+static uint8_t ssd[ssd1306_buffer_length];
+static visualizer_mode_t visualizer_mode = VISUALIZER_SPECTRUM;
+static const char *visualizer_title = "";
+static uint64_t frame_samples = 0; // Amostras desde o último quadro
+static uint32_t frame_rate = 0;    // Taxa do áudio que anda o relógio dos quadros
+
+// Streaming: o arquivo faz o papel da USB CDC
+static FILE *stream_file = NULL;
+
+static uint32_t input_source(int16_t *samples, uint32_t count)
+{
+    return wav_read(&input_wav, samples, count);
+}
+
+static void frame_start(const char *title, uint32_t sample_rate)
+{
+    visualizer_reset();
+    visualizer_title = title;
+    frame_rate = sample_rate;
+    frame_samples = 0;
+}
+
+// Desenha um quadro (título na primeira página e o gráfico nas outras) a cada VISUALIZER_FRAME_MS
+static void frame_advance(uint count)
+{
+    frame_samples += count;
+    if (frame_samples * 1000 < (uint64_t)frame_rate * VISUALIZER_FRAME_MS)
+    {
+        return;
+    }
+    frame_samples -= (uint64_t)frame_rate * VISUALIZER_FRAME_MS / 1000;
+
+    memset(ssd, 0, ssd1306_page_height * ssd1306_width);
+    ssd1306_draw_text(ssd, 0, 0, visualizer_title, ssd1306_draw_set);
+    visualizer_render(ssd, ssd1306_page_height, ssd1306_height - ssd1306_page_height, visualizer_mode);
+    render_changes_on_display_async(ssd, NULL);
+}
+
+// Consumidor da captura na gravação: o mesmo trabalho do record_block_handler do firmware
+static bool record_block_handler(const int16_t *block, uint count)
+{
+    visualizer_feed(block, count);
+    frame_advance(count);
+    return audio_store_write(block, count) == count;
+}
+
+// Consumidor da captura no modo ao vivo: o trabalho do núcleo 1, sem as filas entre os núcleos
+static bool live_block_handler(const int16_t *block, uint count)
+{
+    uint16_t levels[CAPTURE_BLOCK_SIZE];
+
+    voice_process_block(block, levels, count);
+    audio_playback_host_write_levels(levels, count);
+    frame_advance(count);
+    return true;
+}
+
+static void stream_write(const uint8_t *data, uint length)
+{
+    fwrite(data, 1, length, stream_file);
+}
+
+// O laço principal do firmware envia os quadros entre as IRQs; aqui, a cada passo da simulação
+static void stream_service(void)
+{
+    while (audio_stream_service())
+    {
+    }
+}
+
+static double elapsed_ms(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e3 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+// Compara dois WAV amostra por amostra; retorna false se o tamanho ou alguma amostra diferir além de tolerance
+static bool compare_wav(const char *path, const char *reference_path, int tolerance)
+{
+    wav_file_t output, reference;
+    int16_t a[256], b[256];
+    uint64_t total = 0;
+    int max_diff = 0;
+    double square_sum = 0;
+    bool same_length = true;
+
+    if (!wav_open_read(&output, path) || !wav_open_read(&reference, reference_path))
+    {
+        fprintf(stderr, "Erro: nao foi possivel abrir %s para comparar.\n", reference_path);
+        return false;
+    }
+    for (;;)
+    {
+        uint32_t n = wav_read(&output, a, 256);
+        uint32_t m = wav_read(&reference, b, 256);
+        if (n != m)
+        {
+            same_length = false;
+        }
+        n = n < m ? n : m;
+        if (n == 0)
+        {
+            break;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            int diff = abs(a[i] - b[i]);
+            max_diff = diff > max_diff ? diff : max_diff;
+            square_sum += (double)diff * diff;
+        }
+        total += n;
+    }
+    same_length = same_length && output.rate == reference.rate;
+    wav_close(&output);
+    wav_close(&reference);
+
+    double rms = total ? sqrt(square_sum / total) : 0;
+    printf("comparacao: amostras=%llu diferenca_max=%d diferenca_rms=%.2f tamanho_igual=%d\n",
+           (unsigned long long)total, max_diff, rms, same_length);
+    return same_length && max_diff <= tolerance;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "uso: %s [opcoes] entrada.wav saida.wav\n"
+            "  -L          modo ao vivo (sem gravar; saida na taxa de captura)\n"
+            "  -p N        tom em semitons (-%d a +%d)\n"
+            "  -e N        cadeia de efeitos (indice; -l lista)\n"
+            "  -v N        volume (0 a 100)\n"
+            "  -s NUM/DEN  velocidade da reproducao (ex.: 3/2)\n"
+            "  -r HZ       taxa de captura (padrao 12000)\n"
+            "  -o HZ       taxa de reproducao (padrao 16000)\n"
+            "  -8          grava em PCM de 8 bits em vez de ADPCM\n"
+            "  -d DIR      grava os quadros do display em DIR/frame_NNNNN.pgm\n"
+            "  -w          visualizacao da forma de onda em vez do espectro\n"
+            "  -c REF.wav  compara a saida com REF.wav (sai com erro se diferir)\n"
+            "  -t N        diferenca maxima aceita por amostra na comparacao (padrao 0)\n"
+            "  -S          mostra as estatisticas de tempo de cada etapa (linhas JSON)\n"
+            "  -U ARQ      grava o streaming da captura e da saida em ARQ (quadros do stream_receiver)\n"
+            "  -l          lista as cadeias de efeitos\n",
+            program, PITCH_SHIFT_MAX_SEMITONES, PITCH_SHIFT_MAX_SEMITONES);
+}
+
+int main(int argc, char **argv)
+{
+    bool live = false;
+    int semitones = 0;
+    uint effect = 0;
+    uint volume = 0;
+    uint32_t speed_num = 1, speed_den = 1;
+    uint32_t capture_rate = 12000;
+    uint32_t playback_rate = 16000;
+    const char *reference_path = NULL;
+    int tolerance = 0;
+    bool show_stats = false;
+    const char *stream_path = NULL;
+    int option;
+
+    while ((option = getopt(argc, argv, "Lp:e:v:s:r:o:8d:wc:t:SU:l")) != -1)
+    {
+        switch (option)
+        {
+        case 'L':
+            live = true;
+            break;
+        case 'p':
+            semitones = atoi(optarg);
+            break;
+        case 'e':
+            effect = atoi(optarg);
+            break;
+        case 'v':
+            volume = atoi(optarg);
+            break;
+        case 's':
+            if (sscanf(optarg, "%u/%u", &speed_num, &speed_den) != 2 || speed_num == 0 || speed_den == 0)
+            {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'r':
+            capture_rate = atoi(optarg);
+            break;
+        case 'o':
+            playback_rate = atoi(optarg);
+            break;
+        case '8':
+            record_format = AUDIO_STORE_PCM8;
+            break;
+        case 'd':
+            ssd1306_host_set_frame_dir(optarg);
+            break;
+        case 'w':
+            visualizer_mode = VISUALIZER_WAVEFORM;
+            break;
+        case 'c':
+            reference_path = optarg;
+            break;
+        case 't':
+            tolerance = atoi(optarg);
+            break;
+        case 'S':
+            show_stats = true;
+            break;
+        case 'U':
+            stream_path = optarg;
+            break;
+        case 'l':
+            for (uint32_t i = 0; i < effects_chain_count(); i++)
+            {
+                printf("%u %s\n", (unsigned)i, effects_chain_name(i));
+            }
+            return 0;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (argc - optind != 2 || effect >= effects_chain_count() || capture_rate == 0 || playback_rate == 0)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    const char *input_path = argv[optind];
+    const char *output_path = argv[optind + 1];
+
+    if (!wav_open_read(&input_wav, input_path))
+    {
+        fprintf(stderr, "Erro: %s nao e um WAV PCM de 8 ou 16 bits.\n", input_path);
+        return 1;
+    }
+    double input_seconds = (double)input_wav.frames / input_wav.rate;
+
+    if (stream_path)
+    {
+        stream_file = fopen(stream_path, "wb");
+        if (!stream_file)
+        {
+            fprintf(stderr, "Erro: nao foi possivel criar %s.\n", stream_path);
+            return 1;
+        }
+        audio_stream_init(stream_write, NULL);
+        audio_stream_enable((1u << STREAM_SOURCE_CAPTURE) | (1u << STREAM_SOURCE_OUTPUT));
+    }
+
+    ssd1306_init();
+    adc_scheduler_init(capture_rate);
+    capture_rate = adc_scheduler_get_sample_rate();
+    adc_scheduler_host_set_source(MIC_CHANNEL, input_source, input_wav.rate);
+    audio_capture_init(MIC_CHANNEL);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if (live)
+    {
+        if (!wav_open_write(&output_wav, output_path, capture_rate))
+        {
+            fprintf(stderr, "Erro: nao foi possivel criar %s.\n", output_path);
+            return 1;
+        }
+        audio_playback_host_set_output(&output_wav);
+        voice_reset(semitones, effect, volume, capture_rate);
+        frame_start("Ao vivo", capture_rate);
+        audio_capture_start(live_block_handler);
+        while (adc_scheduler_host_step())
+        {
+            stream_service();
+        }
+        stream_service();
+        audio_capture_stop();
+    }
+    else
+    {
+        // Memória de gravação com folga para o arquivo inteiro (no firmware são BUFFER_SIZE bytes)
+        uint32_t samples = (uint64_t)input_wav.frames * capture_rate / input_wav.rate + 2 * CAPTURE_BLOCK_SIZE;
+        record_memory = malloc(samples);
+        audio_store_init(record_memory, samples);
+        audio_store_begin_write(record_format);
+
+        frame_start("Gravando", capture_rate);
+        audio_capture_start(record_block_handler);
+        while (adc_scheduler_host_step() && audio_capture_is_running())
+        {
+            stream_service();
+        }
+        stream_service();
+        audio_capture_stop();
+
+        if (!wav_open_write(&output_wav, output_path, playback_rate))
+        {
+            fprintf(stderr, "Erro: nao foi possivel criar %s.\n", output_path);
+            return 1;
+        }
+        audio_playback_host_set_output(&output_wav);
+        audio_store_begin_read();
+        voice_set_source(capture_rate * speed_num, playback_rate * speed_den);
+        voice_reset(semitones, effect, volume, playback_rate);
+        frame_start("Tocando", playback_rate);
+        audio_playback_start(playback_rate, voice_read_store, NULL);
+        while (audio_playback_host_step())
+        {
+            frame_advance(PLAYBACK_BLOCK_SIZE);
+            stream_service();
+        }
+        stream_service();
+    }
+
+    double cpu_ms = elapsed_ms(&start);
+    double output_seconds = (double)output_wav.frames / output_wav.rate;
+    wav_close(&output_wav);
+    wav_close(&input_wav);
+    free(record_memory);
+    if (stream_file)
+    {
+        fclose(stream_file);
+    }
+
+    printf("entrada=%.3fs saida=%.3fs processamento=%.1fms tempo_real=%.1fx quadros=%u\n",
+           input_seconds, output_seconds, cpu_ms, cpu_ms > 0 ? (input_seconds + output_seconds) * 1e3 / cpu_ms : 0,
+           (unsigned)ssd1306_host_frames());
+
+    if (show_stats)
+    {
+        stats_dump();
+    }
+    if (reference_path && !compare_wav(output_path, reference_path, tolerance))
+    {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "host.h"
+
+// Substituto do envio pelo I2C: o "vidro" do display é um vetor em RAM que recebe o que seria enviado
+static uint8_t ssd1306_glass[ssd1306_buffer_length];
+static const char *ssd1306_frame_dir = NULL;
+static uint32_t ssd1306_frame_count = 0;
+static uint32_t ssd1306_bus_byte_count = 0; // O que iria para o barramento, contado como no firmware
+
+// Cópia do que já foi enviado, para mandar só as colunas alteradas como o ssd1306_i2c.c
+static uint8_t ssd1306_shadow[ssd1306_buffer_length];
+static bool ssd1306_shadow_valid = false;
+
+// Grava o conteúdo do vidro como PGM binário (P5), um byte por pixel
+static void ssd1306_host_dump_frame(void)
+{
+    char path[512];
+    uint8_t row[ssd1306_width];
+
+    if (!ssd1306_frame_dir)
+    {
+        return;
+    }
+    snprintf(path, sizeof(path), "%s/frame_%05u.pgm", ssd1306_frame_dir, (unsigned)ssd1306_frame_count);
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        return;
+    }
+    fprintf(file, "P5\n%d %d\n255\n", ssd1306_width, ssd1306_height);
+    for (int y = 0; y < ssd1306_height; y++)
+    {
+        for (int x = 0; x < ssd1306_width; x++)
+        {
+            row[x] = ssd1306_glass[(y >> 3) * ssd1306_width + x] & (1u << (y & 7)) ? 255 : 0;
+        }
+        fwrite(row, 1, ssd1306_width, file);
+    }
+    fclose(file);
+}
+
+void ssd1306_host_set_frame_dir(const char *frame_dir)
+{
+    ssd1306_frame_dir = frame_dir;
+}
+
+uint32_t ssd1306_host_frames(void)
+{
+    return ssd1306_frame_count;
+}
+
+void calculate_render_area_buffer_length(struct render_area *area)
+{
+    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+}
+
+uint32_t ssd1306_bus_bytes()
+{
+    return ssd1306_bus_byte_count;
+}
+
+void ssd1306_send_command(uint8_t cmd)
+{
+    (void)cmd;
+    ssd1306_bus_byte_count += 3;
+}
+
+void ssd1306_send_command_list(uint8_t *ssd, int number)
+{
+    (void)ssd;
+    ssd1306_bus_byte_count += number + 2;
+}
+
+void ssd1306_send_buffer(uint8_t ssd[], int buffer_length)
+{
+    (void)ssd;
+    ssd1306_bus_byte_count += buffer_length + 2;
+}
+
+void ssd1306_init()
+{
+    memset(ssd1306_glass, 0, sizeof(ssd1306_glass));
+    ssd1306_frame_count = 0;
+    ssd1306_shadow_valid = false;
+}
+
+void ssd1306_scroll(bool set)
+{
+    (void)set;
+}
+
+// Copia a área para o vidro na mesma ordem em que o controlador a receberia (colunas, depois páginas)
+void render_on_display(uint8_t *ssd, struct render_area *area)
+{
+    for (int page = area->start_page; page <= area->end_page; page++)
+    {
+        int width = area->end_column - area->start_column + 1;
+        memcpy(&ssd1306_glass[page * ssd1306_width + area->start_column], ssd, width);
+        ssd += width;
+    }
+    ssd1306_bus_byte_count += (6 + 2) + (area->buffer_length + 2);
+    ssd1306_host_dump_frame();
+    ssd1306_frame_count++;
+}
+
+void ssd1306_invalidate()
+{
+    ssd1306_shadow_valid = false;
+}
+
+bool ssd1306_flush_busy()
+{
+    return false;
+}
+
+void ssd1306_flush_wait()
+{
+}
+
+// Mesma varredura de páginas/colunas alteradas do firmware, mas o envio termina na hora:
+// o quadro é gravado e done é chamado antes de retornar
+bool render_changes_on_display_async(uint8_t *ssd, void (*done)(void))
+{
+    for (int page = 0; page < (int)ssd1306_n_pages; page++)
+    {
+        uint8_t *row = ssd + page * ssd1306_width;
+        uint8_t *shadow_row = ssd1306_shadow + page * ssd1306_width;
+
+        if (ssd1306_shadow_valid && memcmp(row, shadow_row, ssd1306_width) == 0)
+        {
+            continue;
+        }
+        int first = 0;
+        int last = ssd1306_width - 1;
+        if (ssd1306_shadow_valid)
+        {
+            while (row[first] == shadow_row[first])
+                first++;
+            while (row[last] == shadow_row[last])
+                last--;
+        }
+        ssd1306_bus_byte_count += (6 + 2) + (last - first + 1 + 2); // Comandos de endereço + dados
+        memcpy(shadow_row + first, row + first, last - first + 1);
+    }
+    ssd1306_shadow_valid = true;
+
+    memcpy(ssd1306_glass, ssd, ssd1306_buffer_length);
+    ssd1306_host_dump_frame();
+    ssd1306_frame_count++;
+    if (done)
+    {
+        done();
+    }
+    return true;
+}
+
+void render_changes_on_display(uint8_t *ssd)
+{
+    render_changes_on_display_async(ssd, NULL);
+}
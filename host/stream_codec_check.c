@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <string.h>
+#include "stream_codec.h"
+#include "host.h"
+
+// Verificação do protocolo do streaming em laço fechado: stream_encode de um lado e
+// stream_decoder_push do outro, conferindo os quadros byte a byte
+// Casos de erro: bit invertido nas amostras (o CRC-16 tem que rejeitar), lixo antes do sincronismo
+// (o decodificador tem que se ressincronizar) e quadro entregue em vários pedaços
+// Sai com erro se alguma verificação falhar
+
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+static bool check(bool condition, const char *what)
+{
+    checks++;
+    if (!condition)
+    {
+        printf("FALHA: %s\n", what);
+        failures++;
+    }
+    return condition;
+}
+
+static void make_frame(stream_frame_t *frame, uint8_t source, uint8_t count, uint16_t sequence)
+{
+    memset(frame, 0, sizeof(*frame));
+    frame->source = source;
+    frame->count = count;
+    frame->sequence = sequence;
+    frame->rate = source == STREAM_SOURCE_CAPTURE ? 12000 : 16000;
+    for (uint i = 0; i < count; i++)
+    {
+        frame->samples[i] = (int16_t)(sequence * 977 + i * 4099 - 32768); // Cobre os dois sinais e os extremos
+    }
+}
+
+static bool frames_equal(const stream_frame_t *a, const stream_frame_t *b)
+{
+    return a->source == b->source && a->count == b->count && a->sequence == b->sequence && a->rate == b->rate &&
+           memcmp(a->samples, b->samples, a->count * sizeof(int16_t)) == 0;
+}
+
+// Entrega os bytes ao decodificador; retorna quantos quadros saíram, com o último em frame
+static uint push_bytes(stream_decoder_t *decoder, const uint8_t *bytes, uint length, stream_frame_t *frame)
+{
+    uint frames = 0;
+    for (uint i = 0; i < length; i++)
+    {
+        frames += stream_decoder_push(decoder, bytes[i], frame);
+    }
+    return frames;
+}
+
+// Todos os tamanhos e as duas origens, um quadro por vez, conferindo também os bytes do quadro
+// decodificado codificado de novo
+static void check_loopback(void)
+{
+    stream_decoder_t decoder;
+    stream_frame_t sent, received;
+    uint8_t bytes[STREAM_FRAME_MAX], again[STREAM_FRAME_MAX];
+
+    stream_decoder_reset(&decoder);
+    uint16_t sequence = 65530; // Passa pela volta do número de sequência
+    for (uint count = 1; count <= STREAM_MAX_SAMPLES; count++)
+    {
+        for (uint source = 0; source < STREAM_SOURCES; source++, sequence++)
+        {
+            make_frame(&sent, source, count, sequence);
+            uint length = stream_encode(&sent, bytes);
+            check(length == STREAM_HEADER_SIZE + 2 * count + STREAM_CRC_SIZE, "tamanho do quadro codificado");
+
+            memset(&received, 0, sizeof(received));
+            check(push_bytes(&decoder, bytes, length, &received) == 1, "quadro nao decodificado");
+            check(frames_equal(&sent, &received), "quadro decodificado difere do enviado");
+            check(stream_encode(&received, again) == length && memcmp(bytes, again, length) == 0,
+                  "bytes recodificados diferem dos enviados");
+        }
+    }
+    check(decoder.skipped_bytes == 0 && decoder.crc_errors == 0, "bytes descartados num fluxo limpo");
+}
+
+// Cada bit das amostras e do CRC invertido num quadro: o CRC rejeita e o quadro seguinte ainda sai
+static void check_bit_flip(void)
+{
+    stream_decoder_t decoder;
+    stream_frame_t sent, next, received;
+    uint8_t bytes[2 * STREAM_FRAME_MAX];
+
+    make_frame(&sent, STREAM_SOURCE_CAPTURE, 16, 100);
+    make_frame(&next, STREAM_SOURCE_OUTPUT, 8, 101);
+    uint length = stream_encode(&sent, bytes);
+    uint total = length + stream_encode(&next, bytes + length);
+
+    uint rejected = 0, recovered = 0, tries = 0;
+    for (uint bit = STREAM_HEADER_SIZE * 8; bit < length * 8; bit++, tries++)
+    {
+        bytes[bit / 8] ^= 1 << (bit % 8);
+        stream_decoder_reset(&decoder);
+        memset(&received, 0, sizeof(received));
+        uint frames = push_bytes(&decoder, bytes, total, &received);
+        rejected += decoder.crc_errors == 1;
+        recovered += frames == 1 && frames_equal(&next, &received);
+        bytes[bit / 8] ^= 1 << (bit % 8);
+    }
+    printf("bit invertido: tentativas=%u rejeitados=%u recuperados=%u\n", tries, rejected, recovered);
+    check(rejected == tries, "o CRC-16 aceitou um bit invertido");
+    check(recovered == tries, "quadro seguinte perdido depois de um CRC ruim");
+}
+
+// Lixo antes do sincronismo: texto do printf, bytes de sincronismo soltos e um cabeçalho falso
+static void check_resync(void)
+{
+    static const uint8_t junk[] = {
+        'o', 'k', '\r', '\n', STREAM_SYNC_0, 0x00, STREAM_SYNC_0, STREAM_SYNC_0, STREAM_SYNC_1, 0xF0, 10, 0, 0,
+        STREAM_SYNC_0, STREAM_SYNC_1, (STREAM_VERSION << 4) | STREAM_SOURCE_CAPTURE, 0, 0, 0, 0, 0, 'x'};
+    stream_decoder_t decoder;
+    stream_frame_t sent, received;
+    uint8_t bytes[sizeof(junk) + STREAM_FRAME_MAX];
+
+    memcpy(bytes, junk, sizeof(junk));
+    make_frame(&sent, STREAM_SOURCE_OUTPUT, STREAM_MAX_SAMPLES, 7);
+    uint length = sizeof(junk) + stream_encode(&sent, bytes + sizeof(junk));
+
+    stream_decoder_reset(&decoder);
+    check(push_bytes(&decoder, bytes, length, &received) == 1, "sem ressincronismo depois do lixo");
+    check(frames_equal(&sent, &received), "quadro depois do lixo difere do enviado");
+    check(decoder.skipped_bytes == sizeof(junk), "contagem de bytes descartados");
+    check(decoder.length == 0, "bytes sobrando no decodificador");
+}
+
+// Vários quadros seguidos entregues em pedaços de tamanhos variados, como chegam da USB
+static void check_split(void)
+{
+    static const uint chunks[] = {1, 2, 3, 5, 7, 64, 11, 13};
+    stream_decoder_t decoder;
+    stream_frame_t sent[4], received;
+    uint8_t bytes[4 * STREAM_FRAME_MAX];
+    uint length = 0;
+
+    for (uint i = 0; i < count_of(sent); i++)
+    {
+        make_frame(&sent[i], i & 1, 1 + i * 20, 40 + i);
+        length += stream_encode(&sent[i], bytes + length);
+    }
+
+    stream_decoder_reset(&decoder);
+    uint frames = 0;
+    bool in_order = true;
+    for (uint done = 0, k = 0; done < length; k++)
+    {
+        uint n = chunks[k % count_of(chunks)];
+        n = n < length - done ? n : length - done;
+        uint before = frames;
+        frames += push_bytes(&decoder, bytes + done, n, &received);
+        if (frames != before)
+        {
+            in_order = in_order && frames - before == 1 && frames_equal(&sent[frames - 1], &received);
+        }
+        done += n;
+    }
+    check(frames == count_of(sent), "quadros perdidos na entrega em pedacos");
+    check(in_order, "quadro em pedacos difere do enviado");
+}
+
+int main(void)
+{
+    check_loopback();
+    check_bit_flip();
+    check_resync();
+    check_split();
+
+    printf("stream_codec: verificacoes=%u falhas=%u\n", (unsigned)checks, (unsigned)failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "stream_codec.h"
+#include "wav.h"
+
+// Receptor do streaming de áudio: lê os quadros binários que o firmware envia pela USB CDC (ou um
+// arquivo gravado pelo simulador com -U) e grava cada origem num WAV
+// Quadros perdidos (saltos no número de sequência) viram silêncio, para o tempo continuar certo;
+// uma sequência que volta a zero é uma nova sessão e começa outro arquivo
+
+static const char *const source_names[STREAM_SOURCES] = {"captura", "saida"};
+
+typedef struct
+{
+    wav_file_t wav;
+    bool open;
+    uint file_index;        // Arquivos já abertos para esta origem
+    uint16_t next_sequence; // Sequência esperada no próximo quadro
+    uint8_t last_count;
+    uint32_t frames;
+    uint32_t lost_frames;
+    uint64_t samples;
+} receiver_source_t;
+
+static receiver_source_t sources[STREAM_SOURCES];
+static const char *output_prefix;
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_signal(int signal_number)
+{
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+// Abre PREFIXO_origem.wav (ou PREFIXO_origem_N.wav a partir da segunda sessão ou taxa)
+static bool source_open(receiver_source_t *source, uint index, uint32_t rate)
+{
+    char path[1024];
+
+    if (source->open)
+    {
+        wav_close(&source->wav);
+        source->open = false;
+    }
+    if (source->file_index == 0)
+    {
+        snprintf(path, sizeof(path), "%s_%s.wav", output_prefix, source_names[index]);
+    }
+    else
+    {
+        snprintf(path, sizeof(path), "%s_%s_%u.wav", output_prefix, source_names[index], source->file_index + 1);
+    }
+    if (!wav_open_write(&source->wav, path, rate))
+    {
+        fprintf(stderr, "Erro: nao foi possivel criar %s.\n", path);
+        return false;
+    }
+    fprintf(stderr, "gravando %s (%u Hz)\n", path, (unsigned)rate);
+    source->file_index++;
+    source->open = true;
+    return true;
+}
+
+static bool handle_frame(const stream_frame_t *frame)
+{
+    receiver_source_t *source = &sources[frame->source];
+
+    bool restart = source->open && frame->sequence == 0 && source->next_sequence != 0;
+    if (!source->open || restart || frame->rate != source->wav.rate)
+    {
+        if (!source_open(source, frame->source, frame->rate))
+        {
+            return false;
+        }
+    }
+    else if (frame->sequence != source->next_sequence)
+    {
+        // Completa com silêncio os quadros que faltaram, do tamanho do último recebido
+        static const int16_t silence[STREAM_MAX_SAMPLES];
+        uint16_t lost = frame->sequence - source->next_sequence;
+        source->lost_frames += lost;
+        for (uint i = 0; i < lost; i++)
+        {
+            wav_write(&source->wav, silence, source->last_count);
+            source->samples += source->last_count;
+        }
+    }
+
+    wav_write(&source->wav, frame->samples, frame->count);
+    source->next_sequence = frame->sequence + 1;
+    source->last_count = frame->count;
+    source->frames++;
+    source->samples += frame->count;
+    return true;
+}
+
+// Põe o dispositivo serial em modo bruto: sem eco, sem conversão de fim de linha, leitura byte a byte
+static void serial_set_raw(int fd)
+{
+    struct termios options;
+
+    if (tcgetattr(fd, &options) == 0)
+    {
+        cfmakeraw(&options);
+        options.c_cc[VMIN] = 1;
+        options.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &options);
+    }
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "uso: %s [opcoes] entrada prefixo\n"
+            "  entrada     dispositivo da USB CDC (ex.: /dev/ttyACM0), arquivo gravado com o -U do simulador\n"
+            "              ou - para a entrada padrao\n"
+            "  prefixo     grava prefixo_captura.wav e prefixo_saida.wav\n"
+            "  -s C        no dispositivo, envia o comando C ao abrir (c captura, o saida, a ambas) e x ao sair\n"
+            "  -t SEG      para depois de SEG segundos de audio em alguma origem\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    char command = 0;
+    double max_seconds = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "s:t:")) != -1)
+    {
+        switch (option)
+        {
+        case 's':
+            command = optarg[0];
+            break;
+        case 't':
+            max_seconds = atof(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (argc - optind != 2)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    const char *input_path = argv[optind];
+    output_prefix = argv[optind + 1];
+
+    int fd = strcmp(input_path, "-") == 0 ? STDIN_FILENO : open(input_path, O_RDWR | O_NOCTTY);
+    if (fd < 0 && errno == EACCES)
+    {
+        fd = open(input_path, O_RDONLY); // Arquivo só de leitura: sem comandos
+    }
+    if (fd < 0)
+    {
+        fprintf(stderr, "Erro: nao foi possivel abrir %s.\n", input_path);
+        return 1;
+    }
+    bool serial = isatty(fd);
+    if (serial)
+    {
+        serial_set_raw(fd);
+    }
+    if (serial && command && write(fd, &command, 1) != 1)
+    {
+        fprintf(stderr, "Erro: nao foi possivel enviar o comando.\n");
+        return 1;
+    }
+
+    // Sem SA_RESTART: o Ctrl+C interrompe o read e os WAV são fechados com os tamanhos certos
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    stream_decoder_t decoder;
+    stream_frame_t frame;
+    uint8_t bytes[4096];
+    bool ok = true;
+
+    stream_decoder_reset(&decoder);
+    while (ok && !stop_requested)
+    {
+        ssize_t n = read(fd, bytes, sizeof(bytes));
+        if (n <= 0)
+        {
+            break;
+        }
+        for (ssize_t i = 0; i < n && ok; i++)
+        {
+            if (stream_decoder_push(&decoder, bytes[i], &frame))
+            {
+                ok = handle_frame(&frame);
+                receiver_source_t *source = &sources[frame.source];
+                if (max_seconds > 0 && source->samples >= max_seconds * source->wav.rate)
+                {
+                    stop_requested = 1;
+                }
+            }
+        }
+    }
+
+    if (serial && command)
+    {
+        const char stop = 'x';
+        if (write(fd, &stop, 1) != 1)
+        {
+            fprintf(stderr, "Aviso: nao foi possivel desligar o streaming.\n");
+        }
+    }
+    if (fd != STDIN_FILENO)
+    {
+        close(fd);
+    }
+
+    for (uint i = 0; i < STREAM_SOURCES; i++)
+    {
+        receiver_source_t *source = &sources[i];
+        if (source->open)
+        {
+            printf("%s: quadros=%u perdidos=%u amostras=%llu duracao=%.3fs\n", source_names[i],
+                   (unsigned)source->frames, (unsigned)source->lost_frames, (unsigned long long)source->samples,
+                   (double)source->samples / source->wav.rate);
+            wav_close(&source->wav);
+        }
+    }
+    printf("erros_crc=%u bytes_descartados=%u\n", (unsigned)decoder.crc_errors, (unsigned)decoder.skipped_bytes);
+    return ok ? 0 : 1;
+}
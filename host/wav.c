@@ -0,0 +1,156 @@
+#include <string.h>
+#include "wav.h"
+
+#define WAV_HEADER_BYTES 44 // Cabeçalho RIFF + fmt (16 bytes) + data, como escrito por wav_open_write
+
+static uint32_t wav_get_u32(const uint8_t *bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static uint16_t wav_get_u16(const uint8_t *bytes)
+{
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static void wav_put_u32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = value;
+    bytes[1] = value >> 8;
+    bytes[2] = value >> 16;
+    bytes[3] = value >> 24;
+}
+
+static void wav_put_u16(uint8_t *bytes, uint16_t value)
+{
+    bytes[0] = value;
+    bytes[1] = value >> 8;
+}
+
+// Abre um WAV PCM para leitura, percorrendo os chunks até achar fmt e data
+bool wav_open_read(wav_file_t *wav, const char *path)
+{
+    uint8_t header[12];
+    bool format_found = false;
+
+    memset(wav, 0, sizeof(*wav));
+    wav->file = fopen(path, "rb");
+    if (!wav->file)
+    {
+        return false;
+    }
+    if (fread(header, 1, 12, wav->file) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+    {
+        wav_close(wav);
+        return false;
+    }
+
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, wav->file) == 8)
+    {
+        uint32_t size = wav_get_u32(chunk + 4);
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+        {
+            uint8_t format[16];
+            if (fread(format, 1, 16, wav->file) != 16)
+            {
+                break;
+            }
+            wav->channels = wav_get_u16(format + 2);
+            wav->rate = wav_get_u32(format + 4);
+            wav->bits = wav_get_u16(format + 14);
+            format_found = wav_get_u16(format) == 1 && (wav->bits == 8 || wav->bits == 16) &&
+                           (wav->channels == 1 || wav->channels == 2);
+            fseek(wav->file, (size - 16) + (size & 1), SEEK_CUR);
+        }
+        else if (memcmp(chunk, "data", 4) == 0 && format_found)
+        {
+            wav->frames = size / (wav->channels * wav->bits / 8);
+            return true;
+        }
+        else
+        {
+            fseek(wav->file, size + (size & 1), SEEK_CUR); // Chunks têm tamanho par
+        }
+    }
+    wav_close(wav);
+    return false;
+}
+
+// Cria um WAV de 16 bits mono; os tamanhos do cabeçalho são corrigidos em wav_close
+bool wav_open_write(wav_file_t *wav, const char *path, uint32_t rate)
+{
+    uint8_t header[WAV_HEADER_BYTES] = "RIFF\0\0\0\0WAVEfmt \x10\0\0\0\x01\0\x01\0";
+
+    memset(wav, 0, sizeof(*wav));
+    wav->file = fopen(path, "wb");
+    if (!wav->file)
+    {
+        return false;
+    }
+    wav->rate = rate;
+    wav->channels = 1;
+    wav->bits = 16;
+    wav->writing = true;
+
+    wav_put_u32(header + 24, rate);
+    wav_put_u32(header + 28, rate * 2);
+    wav_put_u16(header + 32, 2);
+    wav_put_u16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    return fwrite(header, 1, WAV_HEADER_BYTES, wav->file) == WAV_HEADER_BYTES;
+}
+
+// Lê até count amostras Q15; retorna menos que count no fim do arquivo
+uint32_t wav_read(wav_file_t *wav, int16_t *samples, uint32_t count)
+{
+    uint8_t bytes[4];
+    uint32_t frame_bytes = wav->channels * wav->bits / 8;
+    uint32_t n = 0;
+
+    while (n < count && wav->frames > 0 && fread(bytes, 1, frame_bytes, wav->file) == frame_bytes)
+    {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < wav->channels; c++)
+        {
+            sum += wav->bits == 8 ? (bytes[c] - 128) << 8 : (int16_t)wav_get_u16(bytes + 2 * c);
+        }
+        samples[n++] = sum / wav->channels;
+        wav->frames--;
+    }
+    return n;
+}
+
+void wav_write(wav_file_t *wav, const int16_t *samples, uint32_t count)
+{
+    uint8_t bytes[2];
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        wav_put_u16(bytes, samples[i]);
+        fwrite(bytes, 1, 2, wav->file);
+    }
+    wav->frames += count;
+}
+
+// Fecha o arquivo; na escrita, grava os tamanhos finais de RIFF e data
+void wav_close(wav_file_t *wav)
+{
+    if (!wav->file)
+    {
+        return;
+    }
+    if (wav->writing)
+    {
+        uint8_t size[4];
+        uint32_t data_bytes = wav->frames * 2;
+        fseek(wav->file, 4, SEEK_SET);
+        wav_put_u32(size, WAV_HEADER_BYTES - 8 + data_bytes);
+        fwrite(size, 1, 4, wav->file);
+        fseek(wav->file, 40, SEEK_SET);
+        wav_put_u32(size, data_bytes);
+        fwrite(size, 1, 4, wav->file);
+    }
+    fclose(wav->file);
+    wav->file = NULL;
+}
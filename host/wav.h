@@ -0,0 +1,26 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef wav_inc_h
+#define wav_inc_h
+
+// Arquivo WAV PCM do simulador: leitura de 8 ou 16 bits (mono ou estéreo, misturado para mono)
+// e escrita em 16 bits mono; as amostras trocadas com o resto do código são sempre Q15
+typedef struct
+{
+    FILE *file;
+    uint32_t rate;
+    uint16_t channels;
+    uint16_t bits;
+    uint32_t frames;    // Quadros restantes (leitura) ou escritos (escrita)
+    bool writing;
+} wav_file_t;
+
+extern bool wav_open_read(wav_file_t *wav, const char *path);
+extern bool wav_open_write(wav_file_t *wav, const char *path, uint32_t rate);
+extern uint32_t wav_read(wav_file_t *wav, int16_t *samples, uint32_t count);
+extern void wav_write(wav_file_t *wav, const int16_t *samples, uint32_t count);
+extern void wav_close(wav_file_t *wav);
+
+#endif
@@ -0,0 +1,168 @@
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "adc_scheduler.h"
+#include "stats.h"
+
+#define ADC_SCHEDULER_BLOCK_BYTES (1u << ADC_SCHEDULER_BLOCK_BITS)
+
+static_assert(ADC_SCHEDULER_CHANNELS * ADC_SCHEDULER_FRAMES * sizeof(uint16_t) == ADC_SCHEDULER_BLOCK_BYTES,
+              "bloco do rodízio precisa ser uma potência de 2");
+
+// Dois blocos intercalados (ping-pong), cada um alinhado ao próprio tamanho
+// O endereço de escrita de cada canal DMA dá a volta sozinho (ring), então um atraso na IRQ
+// (por exemplo durante um apagamento da flash) nunca faz o DMA escrever fora do buffer
+static uint16_t adc_scheduler_buffer[2][ADC_SCHEDULER_BLOCK_BYTES / sizeof(uint16_t)] __attribute__((aligned(ADC_SCHEDULER_BLOCK_BYTES)));
+
+// Amostras separadas por canal (demultiplexadas) e o consumidor de cada canal
+static uint16_t adc_scheduler_channel_buffer[ADC_SCHEDULER_CHANNELS][ADC_SCHEDULER_FRAMES];
+static adc_channel_handler_t adc_scheduler_handler[ADC_SCHEDULER_CHANNELS];
+
+// Posição de cada canal dentro do quadro: o rodízio começa no canal 0 e segue a máscara em ordem crescente
+static const int8_t adc_scheduler_slot[5] = {0, 1, 2, -1, 3};
+
+static int adc_scheduler_dma_chan[2] = {-1, -1};
+static uint32_t adc_scheduler_rate = 0;
+
+// Interrupção de fim de bloco: separa o quadro intercalado por canal e entrega a cada consumidor
+static void adc_scheduler_dma_irq_handler(void)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        int chan = adc_scheduler_dma_chan[i];
+        if (chan < 0 || !dma_channel_get_irq0_status(chan))
+        {
+            continue;
+        }
+        dma_channel_acknowledge_irq0(chan);
+        stats_period(STATS_PERIOD_CAPTURE, ADC_SCHEDULER_OUTPUT_FRAMES * 1000000u / adc_scheduler_rate);
+
+        // Flags do FIFO (o bit de erro das amostras está desligado, mas o transbordo continua marcado)
+        // São limpas escrevendo 1, então basta devolver o valor lido
+        uint32_t fcs = adc_hw->fcs;
+        if (fcs & (ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS))
+        {
+            if (fcs & ADC_FCS_OVER_BITS)
+            {
+                stats_count(STATS_ADC_OVERRUN);
+            }
+            if (fcs & ADC_FCS_UNDER_BITS)
+            {
+                stats_count(STATS_ADC_UNDERRUN);
+            }
+            adc_hw->fcs = fcs;
+        }
+
+        const uint16_t *frame = adc_scheduler_buffer[i];
+        for (uint n = 0; n < ADC_SCHEDULER_FRAMES; n++)
+        {
+            for (int slot = 0; slot < ADC_SCHEDULER_CHANNELS; slot++)
+            {
+                adc_scheduler_channel_buffer[slot][n] = *frame++;
+            }
+        }
+
+        for (int slot = 0; slot < ADC_SCHEDULER_CHANNELS; slot++)
+        {
+            if (adc_scheduler_handler[slot])
+            {
+                adc_scheduler_handler[slot](adc_scheduler_channel_buffer[slot], ADC_SCHEDULER_FRAMES);
+            }
+        }
+    }
+}
+
+// Configura o ADC em rodízio e reserva o DMA
+// Cada canal é convertido a sample_rate x ADC_SCHEDULER_OVERSAMPLE (48 ou 96 kHz para áudio a 12 kHz)
+void adc_scheduler_init(uint32_t sample_rate)
+{
+    adc_init();
+
+    // Configura o FIFO do ADC:
+    // - FIFO habilitado
+    // - Requisição de DMA habilitada
+    // - DREQ quando há 1 amostra disponível
+    // - Bit de erro desabilitado
+    // - Sem shift: os 12 bits vão inteiros para a dizimação
+    adc_fifo_setup(
+        true,  // FIFO habilitado
+        true,  // DMA habilitado
+        1,     // DREQ com 1 amostra
+        false, // Bit de erro desabilitado
+        false  // Mantém os 12 bits
+    );
+
+    adc_scheduler_set_sample_rate(sample_rate);
+
+    for (int i = 0; i < 2; i++)
+    {
+        adc_scheduler_dma_chan[i] = dma_claim_unused_channel(true);
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        dma_channel_config cfg = dma_channel_get_default_config(adc_scheduler_dma_chan[i]);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);         // Transferência de 16 bits
+        channel_config_set_read_increment(&cfg, false);                   // Leitura fixa (FIFO do ADC)
+        channel_config_set_write_increment(&cfg, true);                   // Escrita incremental
+        channel_config_set_ring(&cfg, true, ADC_SCHEDULER_BLOCK_BITS);    // Escrita volta ao início do bloco
+        channel_config_set_dreq(&cfg, DREQ_ADC);                          // Sincronização com ADC
+        channel_config_set_chain_to(&cfg, adc_scheduler_dma_chan[1 - i]); // Ao terminar dispara o outro canal
+        dma_channel_configure(
+            adc_scheduler_dma_chan[i],
+            &cfg,
+            adc_scheduler_buffer[i], // Destino: um dos blocos
+            &adc_hw->fifo,           // Origem: FIFO do ADC
+            ADC_SCHEDULER_BLOCK_BYTES / sizeof(uint16_t),
+            false);
+        dma_channel_set_irq0_enabled(adc_scheduler_dma_chan[i], true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, adc_scheduler_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Muda a taxa de saída (amostras de áudio por segundo em cada canal), inclusive com o rodízio rodando
+// Acima de ADC_SCHEDULER_MAX_RATE o ADC não acompanha e a taxa é limitada
+void adc_scheduler_set_sample_rate(uint32_t sample_rate)
+{
+    if (sample_rate > ADC_SCHEDULER_MAX_RATE)
+    {
+        sample_rate = ADC_SCHEDULER_MAX_RATE;
+    }
+    adc_scheduler_rate = sample_rate;
+
+    // O ADC converte um canal por vez, então roda ADC_SCHEDULER_CHANNELS vezes mais rápido
+    // (4 canais x 48 kHz = 192 ksps, ou 384 ksps com sobreamostragem de 8, dentro dos 500 ksps do ADC)
+    float div = (float)clock_get_hz(clk_adc) / (sample_rate * ADC_SCHEDULER_OVERSAMPLE * ADC_SCHEDULER_CHANNELS);
+    adc_set_clkdiv(div - 1); // O ADC leva div + 1 ciclos por conversão
+}
+
+// Taxa de saída em uso (amostras de áudio por segundo em cada canal)
+uint32_t adc_scheduler_get_sample_rate(void)
+{
+    return adc_scheduler_rate;
+}
+
+// Registra o consumidor das amostras de um canal (NULL descarta as amostras)
+void adc_scheduler_set_handler(uint channel, adc_channel_handler_t handler)
+{
+    if (channel < count_of(adc_scheduler_slot) && adc_scheduler_slot[channel] >= 0)
+    {
+        adc_scheduler_handler[adc_scheduler_slot[channel]] = handler;
+    }
+}
+
+// Liga a conversão contínua; a partir daqui o ADC não para mais e os canais chegam por bloco
+void adc_scheduler_start(void)
+{
+    adc_run(false);
+    adc_fifo_drain();
+    adc_select_input(0); // O primeiro quadro começa no canal 0, alinhado com adc_scheduler_slot
+    adc_set_round_robin(ADC_SCHEDULER_CHANNEL_MASK);
+
+    dma_channel_start(adc_scheduler_dma_chan[0]);
+    adc_run(true);
+}
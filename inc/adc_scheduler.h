@@ -0,0 +1,26 @@
+#include "hal.h"
+#include "decimator.h"
+
+#ifndef adc_scheduler_inc_h
+#define adc_scheduler_inc_h
+
+// Rodízio do ADC: canais 0 e 1 (Joystick), 2 (microfone) e 4 (sensor de temperatura, só completa o quadro)
+// Quatro canais de 12 bits deixam cada quadro do DMA com 8 bytes e cada bloco com uma potência de 2
+#define ADC_SCHEDULER_CHANNEL_MASK 0x17
+#define ADC_SCHEDULER_CHANNELS 4
+#define ADC_SCHEDULER_OVERSAMPLE DECIMATOR_FACTOR // Conversões de cada canal por amostra de áudio
+#define ADC_SCHEDULER_OUTPUT_FRAMES 64            // Amostras de áudio por bloco (~5,3 ms a 12 kHz)
+#define ADC_SCHEDULER_FRAMES (ADC_SCHEDULER_OUTPUT_FRAMES * ADC_SCHEDULER_OVERSAMPLE)
+#define ADC_SCHEDULER_BLOCK_BITS (ADC_SCHEDULER_OVERSAMPLE == 8 ? 12 : 11) // log2 dos bytes por bloco (2 ou 4 KB)
+#define ADC_SCHEDULER_MAX_RATE (500000 / (ADC_SCHEDULER_CHANNELS * ADC_SCHEDULER_OVERSAMPLE)) // Limite de 500 ksps do ADC
+
+// Callback chamado (no contexto da IRQ do DMA) com as amostras de 12 bits de um canal a cada bloco
+typedef void (*adc_channel_handler_t)(const uint16_t *samples, uint count);
+
+extern void adc_scheduler_init(uint32_t sample_rate);
+extern void adc_scheduler_set_sample_rate(uint32_t sample_rate);
+extern uint32_t adc_scheduler_get_sample_rate(void);
+extern void adc_scheduler_set_handler(uint channel, adc_channel_handler_t handler);
+extern void adc_scheduler_start(void);
+
+#endif
@@ -0,0 +1,93 @@
+#include "adpcm.h"
+
+// Tabelas padrão do IMA-ADPCM
+static const int8_t adpcm_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8};
+
+static const int16_t adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+void adpcm_init(adpcm_state_t *state)
+{
+    state->predictor = 0;
+    state->index = 0;
+}
+
+// Reconstrói a amostra a partir do código e atualiza o estado (igual no codificador e no decodificador)
+static inline int16_t adpcm_update(adpcm_state_t *state, uint8_t code)
+{
+    int32_t step = adpcm_step_table[state->index];
+
+    // diff = (código + 0.5) * passo / 4, só com deslocamentos e somas
+    int32_t diff = step >> 3;
+    if (code & 4)
+        diff += step;
+    if (code & 2)
+        diff += step >> 1;
+    if (code & 1)
+        diff += step >> 2;
+
+    int32_t predictor = state->predictor + ((code & 8) ? -diff : diff);
+    if (predictor > 32767)
+        predictor = 32767;
+    else if (predictor < -32768)
+        predictor = -32768;
+    state->predictor = predictor;
+
+    int index = state->index + adpcm_index_table[code];
+    if (index < 0)
+        index = 0;
+    else if (index > 88)
+        index = 88;
+    state->index = index;
+
+    return predictor;
+}
+
+// Codifica uma amostra Q15 em um código de 4 bits
+uint8_t adpcm_encode_sample(adpcm_state_t *state, int16_t sample)
+{
+    int32_t step = adpcm_step_table[state->index];
+    int32_t diff = sample - state->predictor;
+    uint8_t code = 0;
+
+    if (diff < 0)
+    {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step)
+    {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step)
+    {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step)
+    {
+        code |= 1;
+    }
+
+    adpcm_update(state, code);
+    return code;
+}
+
+// Decodifica um código de 4 bits em uma amostra Q15
+int16_t adpcm_decode_sample(adpcm_state_t *state, uint8_t code)
+{
+    return adpcm_update(state, code & 0x0F);
+}
@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+#ifndef adpcm_inc_h
+#define adpcm_inc_h
+
+// Estado do codificador/decodificador IMA-ADPCM (4 bits por amostra)
+typedef struct
+{
+    int16_t predictor; // Última amostra reconstruída (Q15)
+    int8_t index;      // Índice na tabela de passos
+} adpcm_state_t;
+
+extern void adpcm_init(adpcm_state_t *state);
+extern uint8_t adpcm_encode_sample(adpcm_state_t *state, int16_t sample);
+extern int16_t adpcm_decode_sample(adpcm_state_t *state, uint8_t code);
+
+#endif
@@ -0,0 +1,70 @@
+#include "hal.h"
+#include "adc_scheduler.h"
+#include "decimator.h"
+#include "frontend.h"
+#include "audio_capture.h"
+#include "stats.h"
+#include "audio_stream.h"
+
+// O ADC e o DMA ficam com o adc_scheduler, que roda o tempo todo em rodízio com o Joystick
+// A captura decima o canal do microfone (sobreamostrado em 12 bits), passa pela etapa de entrada
+// (bloqueio de DC, AGC e portão de ruído) e entrega os blocos ao consumidor
+static capture_block_handler_t capture_handler = NULL;
+static volatile bool capture_running = false;
+static uint32_t capture_rate = 0;
+static decimator_t capture_decimator;
+static frontend_t capture_frontend;
+static int16_t capture_block[CAPTURE_BLOCK_SIZE];
+
+// Bloco do canal do microfone, já separado dos outros canais (contexto da IRQ do DMA)
+// CIC + FIR de 31 taps: ~25 ciclos por amostra de entrada, bem abaixo de 5% de um núcleo
+static void audio_capture_channel_handler(const uint16_t *samples, uint count)
+{
+    if (!capture_running || !capture_handler)
+    {
+        return;
+    }
+
+    uint32_t start = stats_begin();
+    uint n = decimator_process(&capture_decimator, samples, count, capture_block);
+    frontend_process(&capture_frontend, capture_block, capture_block, n);
+    audio_stream_block(STREAM_SOURCE_CAPTURE, capture_block, n, capture_rate);
+    if (!capture_handler(capture_block, n))
+    {
+        audio_capture_stop();
+    }
+    stats_end(STATS_CAPTURE, start);
+}
+
+// Passa a receber o canal do microfone do rodízio do ADC
+void audio_capture_init(uint adc_channel)
+{
+    adc_scheduler_set_handler(adc_channel, audio_capture_channel_handler);
+}
+
+// Inicia a captura contínua, sem bloquear; os blocos chegam pelo handler
+bool audio_capture_start(capture_block_handler_t handler)
+{
+    if (capture_running)
+    {
+        return false;
+    }
+
+    capture_rate = adc_scheduler_get_sample_rate();
+    decimator_init(&capture_decimator);
+    frontend_init(&capture_frontend, capture_rate);
+    capture_handler = handler;
+    capture_running = true;
+    return true;
+}
+
+// Deixa de entregar blocos; pode ser chamada também de dentro do handler
+void audio_capture_stop(void)
+{
+    capture_running = false;
+}
+
+bool audio_capture_is_running(void)
+{
+    return capture_running;
+}
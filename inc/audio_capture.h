@@ -0,0 +1,18 @@
+#include "hal.h"
+#include "adc_scheduler.h"
+
+#ifndef audio_capture_inc_h
+#define audio_capture_inc_h
+
+#define CAPTURE_BLOCK_SIZE ADC_SCHEDULER_OUTPUT_FRAMES // Amostras do microfone por bloco (~5,3 ms a 12 kHz)
+
+// Callback chamado (no contexto da IRQ do DMA) a cada bloco com amostras Q15 já dizimadas
+// Retorna false para encerrar a captura
+typedef bool (*capture_block_handler_t)(const int16_t *block, uint count);
+
+extern void audio_capture_init(uint adc_channel);
+extern bool audio_capture_start(capture_block_handler_t handler);
+extern void audio_capture_stop(void);
+extern bool audio_capture_is_running(void);
+
+#endif
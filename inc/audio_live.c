@@ -0,0 +1,165 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#include "hardware/sync.h"
+#include "audio_capture.h"
+#include "audio_playback.h"
+#include "audio_queue.h"
+#include "audio_live.h"
+#include "stats.h"
+
+// Os blocos passam inteiros de uma etapa para a outra
+static_assert(CAPTURE_BLOCK_SIZE == AUDIO_QUEUE_BLOCK_SIZE, "bloco da captura difere do bloco da fila");
+static_assert(PLAYBACK_BLOCK_SIZE == AUDIO_QUEUE_BLOCK_SIZE, "bloco da reprodução difere do bloco da fila");
+
+// Latência do microfone ao buzzer, no pior caso (blocos de 64 amostras a 12 kHz):
+// 1 bloco de captura + até 1 bloco esperando a troca de metade + 1 bloco tocando = ~16 ms
+
+static audio_queue_t live_input_queue;  // Captura (IRQ núcleo 0) -> efeitos (núcleo 1)
+static audio_queue_t live_output_queue; // Efeitos (núcleo 1) -> reprodução (IRQ núcleo 0)
+
+static live_process_handler_t live_process = NULL;
+static volatile bool live_running = false;
+// Um contador de descartes por núcleo: o incremento não é atômico, então cada um tem um só escritor
+// (as duas IRQs do núcleo 0 dividem a DMA_IRQ_0 e nunca se interrompem)
+static volatile uint32_t live_dropped_capture = 0; // Núcleo 0: captura e reprodução
+static volatile uint32_t live_dropped_process = 0; // Núcleo 1: fila de saída cheia
+static volatile bool live_core1_parked = false;    // Núcleo 1 viu live_running desligado e não mexe em nada
+
+// Entrega cada bloco capturado ao núcleo 1 (contexto da IRQ do DMA)
+static bool audio_live_capture_handler(const int16_t *block, uint count)
+{
+    uint16_t *slot = audio_queue_write_slot(&live_input_queue);
+    if (!slot)
+    {
+        live_dropped_capture++; // Núcleo 1 atrasado: descarta o bloco para não acumular latência
+        return true;
+    }
+    memcpy(slot, block, count * sizeof(int16_t)); // A fila de entrada leva as amostras Q15 como 16 bits
+    audio_queue_push(&live_input_queue);
+    __sev(); // Acorda o núcleo 1
+    return true;
+}
+
+// Pega o bloco processado mais recente para a reprodução (contexto da IRQ do DMA)
+static uint audio_live_fill_handler(uint16_t *levels, uint count)
+{
+    // Mantém só o bloco mais novo na fila, limitando a latência
+    while (audio_queue_count(&live_output_queue) > 1)
+    {
+        audio_queue_pop(&live_output_queue);
+        live_dropped_capture++;
+    }
+
+    const uint16_t *block = audio_queue_read_slot(&live_output_queue);
+    if (block)
+    {
+        memcpy(levels, block, count * sizeof(uint16_t));
+        audio_queue_pop(&live_output_queue);
+    }
+    else
+    {
+        for (uint i = 0; i < count; i++)
+        {
+            levels[i] = PLAYBACK_LEVEL_MAX / 2 + 1; // Sem dados ainda: silêncio (nível do meio)
+        }
+    }
+    return count; // O modo ao vivo só termina com audio_live_stop()
+}
+
+// Laço do núcleo 1: processa os blocos da fila de entrada para a fila de saída
+static void audio_live_core1_entry(void)
+{
+    // Permite que o núcleo 0 pare este núcleo fora da flash durante gravações na flash
+    flash_safe_execute_core_init();
+
+    while (true)
+    {
+        // Limpa antes de olhar live_running: quem vê o núcleo estacionado com o modo desligado sabe que
+        // ele não está no meio de um bloco
+        live_core1_parked = false;
+        if (!live_running)
+        {
+            live_core1_parked = true;
+            __wfe();
+            continue;
+        }
+
+        const uint16_t *in = audio_queue_read_slot(&live_input_queue);
+        if (!in)
+        {
+            __wfe(); // Dorme até a captura publicar um bloco
+            continue;
+        }
+
+        uint16_t *out = audio_queue_write_slot(&live_output_queue);
+        if (out)
+        {
+            uint32_t start = stats_begin();
+            live_process((const int16_t *)in, out, AUDIO_QUEUE_BLOCK_SIZE);
+            stats_end(STATS_LIVE_PROCESS, start);
+            audio_queue_push(&live_output_queue);
+        }
+        else
+        {
+            live_dropped_process++;
+        }
+        audio_queue_pop(&live_input_queue);
+    }
+}
+
+// Coloca o núcleo 1 para aguardar os blocos do modo ao vivo
+void audio_live_init(void)
+{
+    multicore_launch_core1(audio_live_core1_entry);
+}
+
+// Liga captura, efeitos no núcleo 1 e reprodução ao mesmo tempo
+bool audio_live_start(uint32_t sample_rate, live_process_handler_t process)
+{
+    if (live_running || !process || audio_capture_is_running() || audio_playback_is_running())
+    {
+        return false;
+    }
+
+    // O contador do núcleo 1 só é zerado com ele estacionado, senão o incremento dele pode desfazer o zero
+    while (!live_core1_parked)
+    {
+        tight_loop_contents();
+    }
+    live_process = process;
+    live_dropped_capture = 0;
+    live_dropped_process = 0;
+    audio_queue_reset(&live_input_queue);
+    audio_queue_reset(&live_output_queue);
+    live_running = true;
+    __sev();
+
+    if (!audio_playback_start(sample_rate, audio_live_fill_handler, NULL) ||
+        !audio_capture_start(audio_live_capture_handler))
+    {
+        audio_live_stop();
+        return false;
+    }
+    return true;
+}
+
+// Para captura e reprodução; o núcleo 1 volta a dormir
+void audio_live_stop(void)
+{
+    audio_capture_stop();
+    audio_playback_stop();
+    live_running = false;
+}
+
+bool audio_live_is_running(void)
+{
+    return live_running;
+}
+
+// Blocos descartados por atraso (indicador de que o processamento não cabe no tempo)
+uint32_t audio_live_dropped_blocks(void)
+{
+    return live_dropped_capture + live_dropped_process;
+}
@@ -0,0 +1,16 @@
+#include "hal.h"
+
+#ifndef audio_live_inc_h
+#define audio_live_inc_h
+
+// Processamento de um bloco do modo ao vivo, executado no núcleo 1
+// Recebe as amostras Q15 do microfone e escreve os níveis da reprodução (0 a PLAYBACK_LEVEL_MAX)
+typedef void (*live_process_handler_t)(const int16_t *in, uint16_t *out, uint count);
+
+extern void audio_live_init(void);
+extern bool audio_live_start(uint32_t sample_rate, live_process_handler_t process);
+extern void audio_live_stop(void);
+extern bool audio_live_is_running(void);
+extern uint32_t audio_live_dropped_blocks(void);
+
+#endif
@@ -0,0 +1,293 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "audio_playback.h"
+#include "stats.h"
+#include "audio_stream.h"
+#include "audio_pwm.pio.h"
+
+#define PLAYBACK_WORDS (PLAYBACK_BLOCK_SIZE * PLAYBACK_OVERSAMPLE / 2) // Palavras por metade (2 períodos cada)
+
+// Períodos de PWM prontos para o FIFO do PIO: dois níveis de 16 bits por palavra
+// A mesma palavra serve para os dois buzzers, cada um numa máquina de estados
+static uint32_t playback_buffer[2][PLAYBACK_WORDS];
+static uint16_t playback_levels[PLAYBACK_BLOCK_SIZE];
+
+// Um par de canais ping-pong para cada máquina de estados: playback_dma_chan[sm][metade]
+// O ritmo vem do próprio PIO (DREQ do FIFO), sem timer do DMA e sem CPU por amostra
+static int playback_dma_chan[2][2] = {{-1, -1}, {-1, -1}};
+static dma_channel_config playback_dma_cfg[2][2];
+static PIO playback_pio = pio0;
+static uint playback_pio_offset;
+static uint playback_sm[2];
+static uint playback_pin[2];
+
+// Estado da conversão de nível (16 bits) para períodos de PWM (8 bits)
+static uint32_t playback_previous_level = PLAYBACK_LEVEL_MAX / 2 + 1;
+static int32_t playback_error[2]; // Erros de quantização dos dois últimos períodos
+
+static uint32_t playback_rate = 0;     // Taxa da reprodução atual
+static uint32_t playback_block_us = 0; // Duração de uma metade na taxa atual
+static playback_fill_handler_t playback_fill = NULL;
+static playback_done_handler_t playback_done = NULL;
+static volatile bool playback_running = false;
+static int playback_last_block = -1;   // Metade que contém o fim do áudio (-1 enquanto houver dados)
+static uint8_t playback_block_done[2]; // Bits dos slices que já terminaram cada metade
+
+// Converte um nível de 16 bits no nível de um período do PWM (0 a PLAYBACK_PWM_WRAP)
+// Modulador sigma-delta de 2ª ordem (realimentação do erro 2e[n-1] - e[n-2]): o erro de quantizar
+// para 8 bits é empurrado para perto da frequência dos períodos, bem acima da banda de áudio
+static inline uint16_t audio_playback_shape(int32_t level)
+{
+    const int32_t step = (PLAYBACK_LEVEL_MAX + 1) / (PLAYBACK_PWM_WRAP + 1);
+
+    int32_t wanted = level + 2 * playback_error[0] - playback_error[1];
+    if (wanted < 0)
+    {
+        wanted = 0; // Limitar antes de quantizar mantém o erro pequeno e o laço estável
+    }
+    else if (wanted > PLAYBACK_LEVEL_MAX)
+    {
+        wanted = PLAYBACK_LEVEL_MAX;
+    }
+    int32_t period = (wanted + step / 2) / step;
+    if (period > PLAYBACK_PWM_WRAP)
+    {
+        period = PLAYBACK_PWM_WRAP;
+    }
+    playback_error[1] = playback_error[0];
+    playback_error[0] = wanted - period * step;
+    return (uint16_t)period;
+}
+
+// Preenche uma metade do buffer com os períodos do PWM; devolve false se o áudio acabou nela
+// Cada amostra vira PLAYBACK_OVERSAMPLE períodos, interpolados linearmente a partir da amostra anterior
+static bool audio_playback_fill_block(int half)
+{
+    uint32_t start = stats_begin();
+    uint count = playback_fill ? playback_fill(playback_levels, PLAYBACK_BLOCK_SIZE) : 0;
+    audio_stream_levels(playback_levels, count, playback_rate);
+    uint16_t *periods = (uint16_t *)playback_buffer[half];
+
+    for (uint i = 0; i < PLAYBACK_BLOCK_SIZE; i++)
+    {
+        uint32_t level = i < count ? playback_levels[i] : PLAYBACK_LEVEL_MAX / 2 + 1; // Completa com silêncio
+        int32_t delta = (int32_t)level - (int32_t)playback_previous_level;
+        for (int k = 1; k <= PLAYBACK_OVERSAMPLE; k++)
+        {
+            *periods++ = audio_playback_shape(playback_previous_level + delta * k / PLAYBACK_OVERSAMPLE);
+        }
+        playback_previous_level = level;
+    }
+    stats_end(STATS_PLAYBACK_FILL, start);
+    return count == PLAYBACK_BLOCK_SIZE;
+}
+
+// Interrompe o encadeamento dos canais de uma metade, para o DMA parar quando ela terminar
+static void audio_playback_unchain(int half)
+{
+    for (int s = 0; s < 2; s++)
+    {
+        dma_channel_config cfg = playback_dma_cfg[s][half];
+        channel_config_set_chain_to(&cfg, playback_dma_chan[s][half]);
+        dma_channel_set_config(playback_dma_chan[s][half], &cfg, false);
+    }
+}
+
+// Indica se os canais das duas máquinas de estados já terminaram a metade (com ou sem IRQ tratada)
+static bool audio_playback_half_finished(int half)
+{
+    for (int s = 0; s < 2; s++)
+    {
+        if (!(playback_block_done[half] & (1u << s)) && !dma_channel_get_irq0_status(playback_dma_chan[s][half]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Interrupção de fim de bloco: quando os dois slices terminam uma metade, ela é preenchida de novo
+static void audio_playback_dma_irq_handler(void)
+{
+    for (int half = 0; half < 2; half++)
+    {
+        for (int s = 0; s < 2; s++)
+        {
+            int chan = playback_dma_chan[s][half];
+            if (chan >= 0 && dma_channel_get_irq0_status(chan))
+            {
+                dma_channel_acknowledge_irq0(chan);
+                playback_block_done[half] |= 1u << s;
+            }
+        }
+
+        if (playback_block_done[half] != 0x3 || !playback_running)
+        {
+            continue;
+        }
+        playback_block_done[half] = 0;
+        stats_period(STATS_PERIOD_PLAYBACK, playback_block_us);
+
+        // A outra metade também já terminou: o DMA passou a ler esta antes de ela ser preenchida
+        if (half != playback_last_block && audio_playback_half_finished(1 - half))
+        {
+            stats_count(STATS_PLAYBACK_UNDERRUN);
+        }
+
+        if (half == playback_last_block)
+        {
+            audio_playback_stop();
+            if (playback_done)
+            {
+                playback_done();
+            }
+            return;
+        }
+
+        // A outra metade já está tocando; os endereços de leitura desta voltam ao início
+        for (int s = 0; s < 2; s++)
+        {
+            dma_channel_set_read_addr(playback_dma_chan[s][half], playback_buffer[half], false);
+        }
+        if (playback_last_block < 0 && !audio_playback_fill_block(half))
+        {
+            playback_last_block = half;
+            audio_playback_unchain(half);
+        }
+    }
+}
+
+// Carrega o programa de PWM no PIO, uma máquina de estados por buzzer, e reserva os canais DMA
+void audio_playback_init(uint gpio_a, uint gpio_b)
+{
+    playback_pin[0] = gpio_a;
+    playback_pin[1] = gpio_b;
+    playback_pio_offset = pio_add_program(playback_pio, &audio_pwm_program);
+
+    for (int s = 0; s < 2; s++)
+    {
+        playback_sm[s] = pio_claim_unused_sm(playback_pio, true);
+        audio_pwm_program_init(playback_pio, playback_sm[s], playback_pio_offset, playback_pin[s], PLAYBACK_PWM_WRAP);
+        for (int half = 0; half < 2; half++)
+        {
+            playback_dma_chan[s][half] = dma_claim_unused_channel(true);
+        }
+    }
+
+    for (int s = 0; s < 2; s++)
+    {
+        for (int half = 0; half < 2; half++)
+        {
+            dma_channel_config cfg = dma_channel_get_default_config(playback_dma_chan[s][half]);
+            channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);                          // Dois períodos por palavra
+            channel_config_set_read_increment(&cfg, true);                                     // Leitura incremental (buffer)
+            channel_config_set_write_increment(&cfg, false);                                   // Escrita fixa (FIFO do PIO)
+            channel_config_set_dreq(&cfg, pio_get_dreq(playback_pio, playback_sm[s], true));   // Ritmo dado pelo PIO
+            channel_config_set_chain_to(&cfg, playback_dma_chan[s][1 - half]);                 // Ao terminar dispara a outra metade
+            playback_dma_cfg[s][half] = cfg;
+        }
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, audio_playback_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Inicia a reprodução sem bloquear; os blocos são pedidos ao fill conforme o DMA avança
+bool audio_playback_start(uint32_t sample_rate, playback_fill_handler_t fill, playback_done_handler_t done)
+{
+    if (playback_running || playback_dma_chan[0][0] < 0 || sample_rate == 0)
+    {
+        return false;
+    }
+
+    playback_fill = fill;
+    playback_done = done;
+    playback_last_block = -1;
+    playback_block_done[0] = playback_block_done[1] = 0;
+    playback_previous_level = PLAYBACK_LEVEL_MAX / 2 + 1;
+    playback_error[0] = playback_error[1] = 0;
+    playback_rate = sample_rate;
+    playback_block_us = PLAYBACK_BLOCK_SIZE * 1000000u / sample_rate;
+    stats_period_restart(STATS_PERIOD_PLAYBACK);
+
+    // As duas metades são preenchidas antes de começar
+    for (int half = 0; half < 2; half++)
+    {
+        if (playback_last_block < 0 && !audio_playback_fill_block(half))
+        {
+            playback_last_block = half;
+        }
+    }
+
+    uint32_t mask = 0;
+    uint32_t sm_mask = 0;
+    for (int s = 0; s < 2; s++)
+    {
+        // PLAYBACK_OVERSAMPLE períodos por amostra (64 kHz de portadora a 16 kHz, acima do audível)
+        audio_pwm_program_reset(playback_pio, playback_sm[s], playback_pio_offset, playback_pin[s], PLAYBACK_PWM_WRAP);
+        audio_pwm_program_set_rate(playback_pio, playback_sm[s], PLAYBACK_PWM_WRAP, sample_rate * PLAYBACK_OVERSAMPLE);
+        sm_mask |= 1u << playback_sm[s];
+
+        for (int half = 0; half < 2; half++)
+        {
+            int chan = playback_dma_chan[s][half];
+            dma_channel_configure(
+                chan,
+                &playback_dma_cfg[s][half],
+                &playback_pio->txf[playback_sm[s]], // Destino: FIFO da máquina de estados
+                playback_buffer[half],              // Origem: períodos pré-calculados
+                PLAYBACK_WORDS,
+                false);
+            dma_channel_acknowledge_irq0(chan);
+            dma_channel_set_irq0_enabled(chan, true);
+        }
+        mask |= 1u << playback_dma_chan[s][0];
+    }
+    if (playback_last_block >= 0)
+    {
+        audio_playback_unchain(playback_last_block);
+    }
+
+    playback_running = true;
+
+    // O DMA enche os FIFOs e as duas máquinas começam no mesmo ciclo, com o mesmo divisor, ficando em sincronia
+    dma_start_channel_mask(mask);
+    pio_enable_sm_mask_in_sync(playback_pio, sm_mask);
+    return true;
+}
+
+// Para os canais e as máquinas de estados, deixando os pinos em 0; pode ser chamada de dentro dos handlers
+void audio_playback_stop(void)
+{
+    if (!playback_running)
+    {
+        return;
+    }
+    playback_running = false;
+
+    for (int half = 0; half < 2; half++)
+    {
+        audio_playback_unchain(half);
+        for (int s = 0; s < 2; s++)
+        {
+            dma_channel_set_irq0_enabled(playback_dma_chan[s][half], false);
+        }
+    }
+    for (int s = 0; s < 2; s++)
+    {
+        for (int half = 0; half < 2; half++)
+        {
+            dma_channel_abort(playback_dma_chan[s][half]);
+            dma_channel_acknowledge_irq0(playback_dma_chan[s][half]);
+        }
+        audio_pwm_program_reset(playback_pio, playback_sm[s], playback_pio_offset, playback_pin[s], PLAYBACK_PWM_WRAP);
+    }
+}
+
+bool audio_playback_is_running(void)
+{
+    return playback_running;
+}
@@ -0,0 +1,23 @@
+#include "hal.h"
+
+#ifndef audio_playback_inc_h
+#define audio_playback_inc_h
+
+#define PLAYBACK_BLOCK_SIZE 64  // Amostras em cada metade do buffer de reprodução (~5,3 ms a 12 kHz)
+#define PLAYBACK_LEVEL_MAX 65535 // Nível máximo de uma amostra (metade = silêncio)
+#define PLAYBACK_PWM_WRAP 255    // Resolução de cada período do PWM gerado pelo PIO
+#define PLAYBACK_OVERSAMPLE 4    // Períodos do PWM por amostra (par: dois períodos por palavra do FIFO)
+
+// Callback chamado (no contexto da IRQ do DMA) para preencher um bloco com níveis de 0 a PLAYBACK_LEVEL_MAX
+// Retorna quantos níveis escreveu; menos que count encerra a reprodução após este bloco
+typedef uint (*playback_fill_handler_t)(uint16_t *levels, uint count);
+
+// Callback chamado (no contexto da IRQ do DMA) quando o último bloco termina de tocar
+typedef void (*playback_done_handler_t)(void);
+
+extern void audio_playback_init(uint gpio_a, uint gpio_b);
+extern bool audio_playback_start(uint32_t sample_rate, playback_fill_handler_t fill, playback_done_handler_t done);
+extern void audio_playback_stop(void);
+extern bool audio_playback_is_running(void);
+
+#endif
@@ -0,0 +1,50 @@
+#include "hal.h"
+#include "audio_queue.h"
+
+// Esvazia a fila; só pode ser chamada com produtor e consumidor parados
+void audio_queue_reset(audio_queue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+// Quantidade de blocos prontos para leitura
+uint audio_queue_count(const audio_queue_t *queue)
+{
+    return queue->head - queue->tail;
+}
+
+// Bloco livre para o produtor preencher, ou NULL se a fila estiver cheia
+uint16_t *audio_queue_write_slot(audio_queue_t *queue)
+{
+    if (queue->head - queue->tail >= AUDIO_QUEUE_DEPTH)
+    {
+        return NULL;
+    }
+    return queue->blocks[queue->head & (AUDIO_QUEUE_DEPTH - 1)];
+}
+
+// Publica o bloco preenchido em audio_queue_write_slot()
+void audio_queue_push(audio_queue_t *queue)
+{
+    hal_memory_barrier(); // Os dados do bloco ficam visíveis antes do novo head
+    queue->head++;
+}
+
+// Bloco mais antigo pronto para o consumidor, ou NULL se a fila estiver vazia
+const uint16_t *audio_queue_read_slot(const audio_queue_t *queue)
+{
+    if (queue->head == queue->tail)
+    {
+        return NULL;
+    }
+    hal_memory_barrier(); // Lê o bloco só depois de ver o head que o publicou
+    return queue->blocks[queue->tail & (AUDIO_QUEUE_DEPTH - 1)];
+}
+
+// Libera o bloco lido em audio_queue_read_slot()
+void audio_queue_pop(audio_queue_t *queue)
+{
+    hal_memory_barrier(); // Termina de ler o bloco antes de devolvê-lo ao produtor
+    queue->tail++;
+}
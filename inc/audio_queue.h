@@ -0,0 +1,25 @@
+#include "hal.h"
+
+#ifndef audio_queue_inc_h
+#define audio_queue_inc_h
+
+#define AUDIO_QUEUE_BLOCK_SIZE 64 // Amostras por bloco (~5,3 ms a 12 kHz)
+#define AUDIO_QUEUE_DEPTH 4       // Blocos na fila (potência de 2)
+
+// Fila de blocos sem trava para um produtor e um consumidor (SPSC)
+// Cada índice é escrito por um único lado, então funciona entre IRQ e laço principal ou entre os dois núcleos
+typedef struct
+{
+    uint16_t blocks[AUDIO_QUEUE_DEPTH][AUDIO_QUEUE_BLOCK_SIZE];
+    volatile uint32_t head; // Escrito só pelo produtor
+    volatile uint32_t tail; // Escrito só pelo consumidor
+} audio_queue_t;
+
+extern void audio_queue_reset(audio_queue_t *queue);
+extern uint audio_queue_count(const audio_queue_t *queue);
+extern uint16_t *audio_queue_write_slot(audio_queue_t *queue);
+extern void audio_queue_push(audio_queue_t *queue);
+extern const uint16_t *audio_queue_read_slot(const audio_queue_t *queue);
+extern void audio_queue_pop(audio_queue_t *queue);
+
+#endif
@@ -0,0 +1,166 @@
+#include "audio_store.h"
+
+// Memória onde as amostras ficam guardadas (fornecida por quem usa o módulo)
+static uint8_t *store_memory = 0;
+static uint32_t store_size = 0;
+
+static audio_store_format_t store_format = AUDIO_STORE_PCM8;
+static uint32_t store_length = 0; // Amostras gravadas
+
+// Origem da leitura: a própria memória ou uma gravação externa (por exemplo na flash, via XIP)
+static const uint8_t *read_memory = 0;
+static audio_store_format_t read_format = AUDIO_STORE_PCM8;
+static uint32_t read_length = 0;
+static uint32_t read_position = 0; // Próxima amostra a ler
+static adpcm_state_t store_encoder;
+static adpcm_state_t store_decoder;
+
+// Amostra de 8 bits sem sinal (centro em 128) para Q15 e de volta
+static inline int16_t audio_store_u8_to_q15(uint8_t sample)
+{
+    return (int16_t)((sample - 128) * 256); // Multiplicação: deslocar um negativo para a esquerda é indefinido
+}
+
+static inline uint8_t audio_store_q15_to_u8(int16_t sample)
+{
+    return (uint8_t)((sample >> 8) + 128);
+}
+
+// Define a memória usada pelo armazenamento
+void audio_store_init(uint8_t *memory, uint32_t size)
+{
+    store_memory = memory;
+    store_size = size;
+    store_length = 0;
+    read_length = 0;
+    read_position = 0;
+}
+
+// Quantas amostras cabem na memória em cada formato
+uint32_t audio_store_capacity(audio_store_format_t format)
+{
+    return format == AUDIO_STORE_ADPCM ? store_size * 2 : store_size;
+}
+
+// Descarta a gravação anterior e começa uma nova
+void audio_store_begin_write(audio_store_format_t format)
+{
+    store_format = format;
+    store_length = 0;
+    adpcm_init(&store_encoder);
+}
+
+// Acrescenta amostras Q15; retorna quantas couberam
+uint32_t audio_store_write(const int16_t *samples, uint32_t count)
+{
+    uint32_t space = audio_store_capacity(store_format) - store_length;
+    if (count > space)
+    {
+        count = space;
+    }
+
+    if (store_format == AUDIO_STORE_PCM8)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            store_memory[store_length + i] = audio_store_q15_to_u8(samples[i]);
+        }
+    }
+    else
+    {
+        // Dois códigos por byte, nibble baixo primeiro
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t n = store_length + i;
+            uint8_t code = adpcm_encode_sample(&store_encoder, samples[i]);
+            if (n & 1)
+            {
+                store_memory[n >> 1] |= code << 4;
+            }
+            else
+            {
+                store_memory[n >> 1] = code;
+            }
+        }
+    }
+    store_length += count;
+    return count;
+}
+
+// Quantidade de amostras gravadas
+uint32_t audio_store_length(void)
+{
+    return store_length;
+}
+
+// Descarta o final da gravação, mantendo as primeiras length amostras
+// O ADPCM só depende das amostras anteriores, então cortar o final não afeta o que fica
+void audio_store_truncate(uint32_t length)
+{
+    if (length < store_length)
+    {
+        store_length = length;
+    }
+}
+
+// Bytes ocupados pela gravação
+uint32_t audio_store_size_bytes(void)
+{
+    return store_format == AUDIO_STORE_ADPCM ? (store_length + 1) / 2 : store_length;
+}
+
+// Bytes que não mudam mais enquanto a gravação continua (o último nibble ADPCM ainda pode ser completado)
+uint32_t audio_store_stable_bytes(void)
+{
+    return store_format == AUDIO_STORE_ADPCM ? store_length / 2 : store_length;
+}
+
+const uint8_t *audio_store_data(void)
+{
+    return store_memory;
+}
+
+// Volta a leitura para o início da gravação guardada na memória
+void audio_store_begin_read(void)
+{
+    audio_store_open(store_memory, store_length, store_format);
+}
+
+// Lê uma gravação que está em outra memória, sem copiar para a RAM
+void audio_store_open(const uint8_t *data, uint32_t length, audio_store_format_t format)
+{
+    read_memory = data;
+    read_length = length;
+    read_format = format;
+    read_position = 0;
+    adpcm_init(&store_decoder);
+}
+
+// Lê (decodificando na hora, se for ADPCM) as próximas amostras em Q15; retorna quantas leu
+uint32_t audio_store_read(int16_t *samples, uint32_t count)
+{
+    uint32_t remaining = read_length - read_position;
+    if (count > remaining)
+    {
+        count = remaining;
+    }
+
+    if (read_format == AUDIO_STORE_PCM8)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            samples[i] = audio_store_u8_to_q15(read_memory[read_position + i]);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t n = read_position + i;
+            uint8_t code = read_memory[n >> 1] >> ((n & 1) << 2);
+            samples[i] = adpcm_decode_sample(&store_decoder, code);
+        }
+    }
+    read_position += count;
+    return count;
+}
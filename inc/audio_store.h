@@ -0,0 +1,29 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef audio_store_inc_h
+#define audio_store_inc_h
+
+#include "adpcm.h"
+
+// Formato das amostras guardadas
+typedef enum
+{
+    AUDIO_STORE_PCM8, // 1 byte por amostra
+    AUDIO_STORE_ADPCM // IMA-ADPCM, 4 bits por amostra
+} audio_store_format_t;
+
+extern void audio_store_init(uint8_t *memory, uint32_t size);
+extern uint32_t audio_store_capacity(audio_store_format_t format);
+extern void audio_store_begin_write(audio_store_format_t format);
+extern uint32_t audio_store_write(const int16_t *samples, uint32_t count);
+extern uint32_t audio_store_length(void);
+extern void audio_store_truncate(uint32_t length);
+extern uint32_t audio_store_size_bytes(void);
+extern uint32_t audio_store_stable_bytes(void);
+extern const uint8_t *audio_store_data(void);
+extern void audio_store_begin_read(void);
+extern void audio_store_open(const uint8_t *data, uint32_t length, audio_store_format_t format);
+extern uint32_t audio_store_read(int16_t *samples, uint32_t count);
+
+#endif
@@ -0,0 +1,134 @@
+#include <string.h>
+#include "audio_playback.h"
+#include "audio_stream.h"
+
+// Streaming do áudio para o computador, sem nunca segurar a captura
+// Produtor: as IRQs do DMA do núcleo 0 (captura e reprodução dividem a DMA_IRQ_0, então nunca se
+// interrompem) copiam cada bloco para um quadro livre e seguem; sem quadro livre o bloco é descartado,
+// mas a sequência avança e o receptor vê o buraco
+// Consumidor: o laço principal monta o quadro (cabeçalho e CRC) e o escreve no link, fora das IRQs
+
+typedef struct
+{
+    stream_frame_t frames[AUDIO_STREAM_DEPTH];
+    volatile uint32_t head; // Escrito só pelo produtor
+    volatile uint32_t tail; // Escrito só pelo consumidor
+} audio_stream_queue_t;
+
+static audio_stream_queue_t stream_queue;
+static audio_stream_write_handler_t stream_write = NULL;
+static audio_stream_ready_handler_t stream_ready = NULL;
+static volatile uint stream_sources = 0; // Máscara de bits (1 << stream_source_t)
+static uint16_t stream_sequence[STREAM_SOURCES];
+static volatile uint32_t stream_dropped = 0;
+
+void audio_stream_init(audio_stream_write_handler_t write, audio_stream_ready_handler_t ready)
+{
+    stream_write = write;
+    stream_ready = ready;
+    stream_sources = 0;
+    stream_queue.head = 0;
+    stream_queue.tail = 0;
+}
+
+// Escolhe as origens enviadas (0 desliga); a sequência de cada origem recomeça do zero
+void audio_stream_enable(uint sources)
+{
+    stream_sources = 0;
+    hal_memory_barrier();
+    memset(stream_sequence, 0, sizeof(stream_sequence));
+    stream_dropped = 0;
+    hal_memory_barrier();
+    stream_sources = sources;
+}
+
+uint audio_stream_sources(void)
+{
+    return stream_sources;
+}
+
+// Enfileira um bloco de amostras Q15 (contexto da IRQ do DMA); só copia, não escreve no link
+void audio_stream_block(stream_source_t source, const int16_t *samples, uint count, uint32_t rate)
+{
+    if (!(stream_sources & (1u << source)))
+    {
+        return;
+    }
+
+    while (count > 0)
+    {
+        uint n = count < STREAM_MAX_SAMPLES ? count : STREAM_MAX_SAMPLES;
+        uint32_t head = stream_queue.head;
+        if (head - stream_queue.tail >= AUDIO_STREAM_DEPTH)
+        {
+            stream_dropped++; // Link atrasado: o receptor vê o número de sequência pulado
+        }
+        else
+        {
+            stream_frame_t *frame = &stream_queue.frames[head % AUDIO_STREAM_DEPTH];
+            frame->source = source;
+            frame->count = n;
+            frame->sequence = stream_sequence[source];
+            frame->rate = rate;
+            memcpy(frame->samples, samples, n * sizeof(int16_t));
+            hal_memory_barrier();
+            stream_queue.head = head + 1;
+            if (stream_ready)
+            {
+                stream_ready();
+            }
+        }
+        stream_sequence[source]++;
+        samples += n;
+        count -= n;
+    }
+}
+
+// Enfileira níveis da reprodução (0 a PLAYBACK_LEVEL_MAX), convertidos para Q15 como no WAV do host
+void audio_stream_levels(const uint16_t *levels, uint count, uint32_t rate)
+{
+    int16_t samples[STREAM_MAX_SAMPLES];
+
+    if (!(stream_sources & (1u << STREAM_SOURCE_OUTPUT)))
+    {
+        return;
+    }
+
+    while (count > 0)
+    {
+        uint n = count < STREAM_MAX_SAMPLES ? count : STREAM_MAX_SAMPLES;
+        for (uint i = 0; i < n; i++)
+        {
+            samples[i] = (int32_t)levels[i] - (PLAYBACK_LEVEL_MAX / 2 + 1);
+        }
+        audio_stream_block(STREAM_SOURCE_OUTPUT, samples, n, rate);
+        levels += n;
+        count -= n;
+    }
+}
+
+// Envia o quadro mais antigo da fila (laço principal); retorna true se ainda restam quadros
+bool audio_stream_service(void)
+{
+    uint8_t bytes[STREAM_FRAME_MAX];
+    uint32_t tail = stream_queue.tail;
+
+    if (tail == stream_queue.head)
+    {
+        return false;
+    }
+    hal_memory_barrier();
+    uint length = stream_encode(&stream_queue.frames[tail % AUDIO_STREAM_DEPTH], bytes);
+    hal_memory_barrier();
+    stream_queue.tail = tail + 1; // O quadro já foi copiado: o produtor pode reaproveitá-lo
+    if (stream_write)
+    {
+        stream_write(bytes, length);
+    }
+    return stream_queue.tail != stream_queue.head;
+}
+
+uint32_t audio_stream_dropped(void)
+{
+    return stream_dropped;
+}
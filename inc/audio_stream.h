@@ -0,0 +1,23 @@
+#include "hal.h"
+#include "stream_codec.h"
+
+#ifndef audio_stream_inc_h
+#define audio_stream_inc_h
+
+#define AUDIO_STREAM_DEPTH 8 // Quadros esperando o envio (potência de 2; ~40 ms de folga a 12 kHz)
+
+// Envia os bytes de um quadro pelo link (no firmware, a USB CDC); chamado só por audio_stream_service
+typedef void (*audio_stream_write_handler_t)(const uint8_t *data, uint length);
+
+// Avisa (no contexto do produtor) que entrou um quadro na fila
+typedef void (*audio_stream_ready_handler_t)(void);
+
+extern void audio_stream_init(audio_stream_write_handler_t write, audio_stream_ready_handler_t ready);
+extern void audio_stream_enable(uint sources);
+extern uint audio_stream_sources(void);
+extern void audio_stream_block(stream_source_t source, const int16_t *samples, uint count, uint32_t rate);
+extern void audio_stream_levels(const uint16_t *levels, uint count, uint32_t rate);
+extern bool audio_stream_service(void);
+extern uint32_t audio_stream_dropped(void);
+
+#endif
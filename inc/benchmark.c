@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include "benchmark.h"
+
+static uint32_t benchmark_count = 0;
+
+// Linha de cabeçalho: alvo e frequência do contador de ciclos (1 GHz no host = ciclos em ns)
+void benchmark_begin(const char *target)
+{
+    hal_cycles_init();
+    benchmark_count = 0;
+    printf("{\"alvo\":\"%s\",\"ciclos_hz\":%lu}\n", target, (unsigned long)hal_cycles_hz());
+}
+
+// Mede uma chamada; o contador de ciclos do RP2040 tem só 24 bits, então o tempo em µs (TIMERAWL)
+// decide quando a chamada foi longa demais para ele e passa a valer no lugar
+static uint32_t benchmark_measure(const benchmark_t *bench, uint32_t cycles_per_us)
+{
+    uint32_t start_us = hal_time_us();
+    uint32_t start = hal_cycles();
+    bench->run();
+    uint32_t cycles = (hal_cycles() - start) & HAL_CYCLES_MASK;
+    uint32_t elapsed_us = hal_time_us() - start_us;
+
+    if ((uint64_t)elapsed_us * cycles_per_us > HAL_CYCLES_MASK / 2)
+    {
+        return elapsed_us * cycles_per_us;
+    }
+    return cycles;
+}
+
+void benchmark_run(const benchmark_t *bench)
+{
+    uint32_t cycles_per_us = hal_cycles_hz() / 1000000;
+    uint32_t cycles_min = UINT32_MAX;
+    uint32_t cycles_max = 0;
+    uint64_t cycles_sum = 0;
+    uint32_t bytes = 0;
+
+    for (uint32_t i = 0; i < bench->iterations; i++)
+    {
+        if (bench->setup)
+        {
+            bench->setup();
+        }
+        uint32_t bytes_before = bench->bus_bytes ? bench->bus_bytes() : 0;
+        uint32_t cycles = benchmark_measure(bench, cycles_per_us);
+        bytes += bench->bus_bytes ? bench->bus_bytes() - bytes_before : 0;
+
+        cycles_sum += cycles;
+        cycles_min = cycles < cycles_min ? cycles : cycles_min;
+        cycles_max = cycles > cycles_max ? cycles : cycles_max;
+    }
+
+    // O mínimo é o número estável (sem IRQs no meio); a média mostra o custo real com elas
+    double mean = bench->iterations ? (double)cycles_sum / bench->iterations : 0;
+    printf("{\"nome\":\"%s\",\"unidade\":\"%s\",\"itens\":%lu,\"iteracoes\":%lu,"
+           "\"ciclos_min\":%lu,\"ciclos_med\":%.1f,\"ciclos_max\":%lu,\"ciclos_por_item\":%.2f,"
+           "\"us_por_chamada\":%.3f,\"bytes_barramento\":%.1f}\n",
+           bench->name, bench->unit, (unsigned long)bench->items, (unsigned long)bench->iterations,
+           (unsigned long)cycles_min, mean, (unsigned long)cycles_max,
+           bench->items ? (double)cycles_min / bench->items : 0, mean / cycles_per_us,
+           bench->iterations ? (double)bytes / bench->iterations : 0);
+    benchmark_count++;
+}
+
+void benchmark_end(void)
+{
+    printf("{\"fim\":%lu}\n", (unsigned long)benchmark_count);
+}
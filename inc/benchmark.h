@@ -0,0 +1,24 @@
+#include "hal.h"
+
+#ifndef benchmark_inc_h
+#define benchmark_inc_h
+
+// Microbenchmark: run é chamada iterations vezes e cada chamada é medida em ciclos (SysTick no RP2040,
+// relógio monotônico em ns no host); setup roda antes de cada chamada, fora da medição
+// Cada resultado sai numa linha JSON, para comparar execuções com ferramentas comuns
+typedef struct
+{
+    const char *name;
+    const char *unit;            // Item medido: "amostra" nos kernels de áudio, "quadro" no display
+    uint32_t items;              // Itens processados por chamada
+    uint32_t iterations;
+    void (*setup)(void);         // Opcional
+    void (*run)(void);
+    uint32_t (*bus_bytes)(void); // Opcional: contador de bytes no barramento, lido antes e depois
+} benchmark_t;
+
+extern void benchmark_begin(const char *target);
+extern void benchmark_run(const benchmark_t *bench);
+extern void benchmark_end(void);
+
+#endif
@@ -0,0 +1,36 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef decimator_inc_h
+#define decimator_inc_h
+
+// Fator total de sobreamostragem do microfone: 4 (48 kHz para 12 kHz) ou 8 (96 kHz para 12 kHz)
+#ifndef DECIMATOR_FACTOR
+#define DECIMATOR_FACTOR 4
+#endif
+
+#define DECIMATOR_CIC_ORDER 3                       // Estágios integrador/pente do CIC
+#define DECIMATOR_CIC_FACTOR (DECIMATOR_FACTOR / 2) // O CIC dizima até 2x a taxa de saída
+#define DECIMATOR_FIR_TAPS 31                       // FIR de compensação, que dizima os 2x finais
+#define DECIMATOR_FIR_HISTORY 32                    // Histórico do FIR (potência de 2)
+
+#if DECIMATOR_FACTOR != 4 && DECIMATOR_FACTOR != 8
+#error "DECIMATOR_FACTOR deve ser 4 ou 8"
+#endif
+
+// Cadeia de dizimação: CIC de 3ª ordem (só somas) seguido de um FIR Q15 que compensa a queda
+// do CIC na banda passante e faz o filtro anti-aliasing de verdade antes da última dizimação por 2
+typedef struct
+{
+    uint32_t integrator[DECIMATOR_CIC_ORDER]; // Aritmética modular: o estouro dos integradores se cancela nos pentes
+    uint32_t comb[DECIMATOR_CIC_ORDER];
+    uint32_t cic_phase;
+    int16_t history[DECIMATOR_FIR_HISTORY];
+    uint32_t history_index;
+    bool fir_phase;
+} decimator_t;
+
+extern void decimator_init(decimator_t *d);
+extern uint32_t decimator_process(decimator_t *d, const uint16_t *in, uint32_t count, int16_t *out);
+
+#endif
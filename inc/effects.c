@@ -0,0 +1,301 @@
+#include <string.h>
+#include "effects.h"
+
+// Seno Q15 de uma volta em 256 passos: LFOs e portadora do modulador em anel
+static const int16_t effects_sine[256] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+    30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+    0, -804, -1608, -2410, -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+};
+
+static inline int16_t effects_saturate(int32_t value)
+{
+    return value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : (int16_t)value;
+}
+
+// Seno com interpolação linear: fase de 32 bits (uma volta = 2^32)
+static inline int32_t effects_sine_at(uint32_t phase)
+{
+    int32_t a = effects_sine[phase >> 24];
+    int32_t b = effects_sine[((phase >> 24) + 1) & 0xFF];
+    int32_t frac = (phase >> 9) & 0x7FFF; // Q15
+    return a + (((b - a) * frac) >> 15);
+}
+
+// Passo da fase para frequency_mhz (mili-hertz) a sample_rate amostras por segundo
+static uint32_t effects_phase_step(uint32_t frequency_mhz, uint32_t sample_rate)
+{
+    return (uint32_t)(((uint64_t)frequency_mhz << 32) / ((uint64_t)sample_rate * 1000));
+}
+
+// ----- Eco: linha de atraso com realimentação -----
+
+typedef struct
+{
+    uint32_t delay_ms;
+    int16_t feedback; // Q15
+    int16_t mix;      // Q15, volume da repetição na saída
+    uint32_t delay;
+    uint32_t index;
+    int16_t line[EFFECTS_ECHO_BUFFER_SIZE];
+} effects_echo_t;
+
+static void effects_echo_reset(void *state, uint32_t sample_rate)
+{
+    effects_echo_t *echo = state;
+    memset(echo->line, 0, sizeof(echo->line));
+    echo->index = 0;
+    echo->delay = sample_rate * echo->delay_ms / 1000;
+    if (echo->delay >= EFFECTS_ECHO_BUFFER_SIZE)
+    {
+        echo->delay = EFFECTS_ECHO_BUFFER_SIZE - 1;
+    }
+}
+
+static void effects_echo_process(void *state, int16_t *block, uint32_t count)
+{
+    effects_echo_t *echo = state;
+    const uint32_t mask = EFFECTS_ECHO_BUFFER_SIZE - 1;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int32_t delayed = echo->line[(echo->index - echo->delay) & mask];
+        echo->line[echo->index] = effects_saturate(block[i] + ((delayed * echo->feedback) >> 15));
+        echo->index = (echo->index + 1) & mask;
+        block[i] = effects_saturate(block[i] + ((delayed * echo->mix) >> 15));
+    }
+}
+
+// ----- Coro / flanger: atraso curto modulado por um LFO, lido com interpolação -----
+
+typedef struct
+{
+    uint32_t base_us;  // Atraso mínimo
+    uint32_t depth_us; // Variação do atraso
+    uint32_t rate_mhz; // Frequência do LFO
+    int16_t feedback;  // Q15 (flanger usa realimentação, coro não)
+    uint32_t base;     // Atrasos em Q16 (amostras)
+    uint32_t depth;
+    uint32_t phase;
+    uint32_t step;
+    uint32_t index;
+    int16_t line[EFFECTS_MOD_BUFFER_SIZE];
+} effects_modulated_t;
+
+static void effects_modulated_reset(void *state, uint32_t sample_rate)
+{
+    effects_modulated_t *mod = state;
+    memset(mod->line, 0, sizeof(mod->line));
+    mod->index = 0;
+    mod->phase = 0;
+    mod->step = effects_phase_step(mod->rate_mhz, sample_rate);
+    mod->base = (uint32_t)(((uint64_t)sample_rate * mod->base_us << 16) / 1000000);
+    mod->depth = (uint32_t)(((uint64_t)sample_rate * mod->depth_us << 16) / 1000000);
+    if ((mod->base + mod->depth) >> 16 >= EFFECTS_MOD_BUFFER_SIZE - 1)
+    {
+        mod->depth = 0;
+        mod->base = (uint32_t)(EFFECTS_MOD_BUFFER_SIZE - 2) << 16;
+    }
+}
+
+static void effects_modulated_process(void *state, int16_t *block, uint32_t count)
+{
+    effects_modulated_t *mod = state;
+    const uint32_t mask = EFFECTS_MOD_BUFFER_SIZE - 1;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        // Atraso = base + profundidade x (1 + seno) / 2, em Q16
+        uint32_t lfo = (uint32_t)(effects_sine_at(mod->phase) + 32768); // 0 a 65535
+        uint32_t delay = mod->base + (mod->depth >> 8) * (lfo >> 8);
+        mod->phase += mod->step;
+
+        uint32_t whole = delay >> 16;
+        int32_t frac = (delay >> 1) & 0x7FFF;
+        int32_t newer = mod->line[(mod->index - whole) & mask];
+        int32_t older = mod->line[(mod->index - whole - 1) & mask];
+        int32_t delayed = newer + (((older - newer) * frac) >> 15);
+
+        mod->line[mod->index] = effects_saturate(block[i] + ((delayed * mod->feedback) >> 15));
+        mod->index = (mod->index + 1) & mask;
+        block[i] = (int16_t)((block[i] + delayed) >> 1);
+    }
+}
+
+// ----- Modulador em anel: multiplica pela senoide da portadora -----
+
+typedef struct
+{
+    uint32_t frequency_mhz;
+    uint32_t phase;
+    uint32_t step;
+} effects_ring_t;
+
+static void effects_ring_reset(void *state, uint32_t sample_rate)
+{
+    effects_ring_t *ring = state;
+    ring->phase = 0;
+    ring->step = effects_phase_step(ring->frequency_mhz, sample_rate);
+}
+
+static void effects_ring_process(void *state, int16_t *block, uint32_t count)
+{
+    effects_ring_t *ring = state;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        block[i] = (int16_t)((block[i] * effects_sine_at(ring->phase)) >> 15);
+        ring->phase += ring->step;
+    }
+}
+
+// ----- Bitcrusher: menos bits e taxa efetiva menor (amostra e retém) -----
+
+typedef struct
+{
+    uint32_t bits;       // Bits mantidos
+    uint32_t target_hz;  // Taxa efetiva
+    uint32_t hold;       // Amostras repetidas
+    uint32_t counter;
+    int16_t held;
+} effects_crusher_t;
+
+static void effects_crusher_reset(void *state, uint32_t sample_rate)
+{
+    effects_crusher_t *crusher = state;
+    crusher->hold = sample_rate / crusher->target_hz;
+    if (crusher->hold == 0)
+    {
+        crusher->hold = 1;
+    }
+    crusher->counter = 0;
+    crusher->held = 0;
+}
+
+static void effects_crusher_process(void *state, int16_t *block, uint32_t count)
+{
+    effects_crusher_t *crusher = state;
+    const int16_t mask = (int16_t)(0xFFFF << (16 - crusher->bits));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (crusher->counter == 0)
+        {
+            crusher->held = block[i] & mask;
+        }
+        crusher->counter = (crusher->counter + 1) % crusher->hold;
+        block[i] = crusher->held;
+    }
+}
+
+// ----- Filtro pente: ressonância em frequency_hz e harmônicos, timbre metálico do robô -----
+
+typedef struct
+{
+    uint32_t frequency_hz;
+    int16_t feedback; // Q15
+    uint32_t delay;
+    uint32_t index;
+    int16_t line[EFFECTS_COMB_BUFFER_SIZE];
+} effects_comb_t;
+
+static void effects_comb_reset(void *state, uint32_t sample_rate)
+{
+    effects_comb_t *comb = state;
+    memset(comb->line, 0, sizeof(comb->line));
+    comb->index = 0;
+    comb->delay = sample_rate / comb->frequency_hz;
+    if (comb->delay >= EFFECTS_COMB_BUFFER_SIZE)
+    {
+        comb->delay = EFFECTS_COMB_BUFFER_SIZE - 1;
+    }
+}
+
+static void effects_comb_process(void *state, int16_t *block, uint32_t count)
+{
+    effects_comb_t *comb = state;
+    const uint32_t mask = EFFECTS_COMB_BUFFER_SIZE - 1;
+    const int32_t input_gain = 32768 - comb->feedback; // Ganho de pico 1 na ressonância
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int32_t delayed = comb->line[(comb->index - comb->delay) & mask];
+        int16_t y = effects_saturate(((block[i] * input_gain) >> 15) + ((delayed * comb->feedback) >> 15));
+        comb->line[comb->index] = y;
+        comb->index = (comb->index + 1) & mask;
+        block[i] = y;
+    }
+}
+
+// ----- Instâncias e cadeias (todas estáticas) -----
+
+static effects_echo_t effects_echo_state = {.delay_ms = 250, .feedback = 13107, .mix = 16384};
+static effects_modulated_t effects_chorus_state = {.base_us = 15000, .depth_us = 8000, .rate_mhz = 800, .feedback = 0};
+static effects_modulated_t effects_flanger_state = {.base_us = 1000, .depth_us = 3000, .rate_mhz = 250, .feedback = 19661};
+static effects_ring_t effects_ring_state = {.frequency_mhz = 440000};
+static effects_ring_t effects_robot_ring_state = {.frequency_mhz = 30000};
+static effects_crusher_t effects_crusher_state = {.bits = 5, .target_hz = 4000};
+static effects_comb_t effects_robot_comb_state = {.frequency_hz = 100, .feedback = 22938};
+
+static const effects_stage_t effects_echo = {effects_echo_reset, effects_echo_process, &effects_echo_state};
+static const effects_stage_t effects_chorus = {effects_modulated_reset, effects_modulated_process, &effects_chorus_state};
+static const effects_stage_t effects_flanger = {effects_modulated_reset, effects_modulated_process, &effects_flanger_state};
+static const effects_stage_t effects_ring = {effects_ring_reset, effects_ring_process, &effects_ring_state};
+static const effects_stage_t effects_robot_ring = {effects_ring_reset, effects_ring_process, &effects_robot_ring_state};
+static const effects_stage_t effects_crusher = {effects_crusher_reset, effects_crusher_process, &effects_crusher_state};
+static const effects_stage_t effects_robot_comb = {effects_comb_reset, effects_comb_process, &effects_robot_comb_state};
+
+// Uma etapa só aparece em uma cadeia ativa por vez, então o estado pode ser compartilhado entre cadeias
+static const effects_chain_t effects_chains[] = {
+    {"Nenhum", {NULL}},
+    {"Eco", {&effects_echo, NULL}},
+    {"Coro", {&effects_chorus, NULL}},
+    {"Flanger", {&effects_flanger, NULL}},
+    {"Anel", {&effects_ring, NULL}},
+    {"8 bits", {&effects_crusher, NULL}},
+    {"Robo", {&effects_robot_comb, &effects_robot_ring, NULL}},
+    {"Robo+Eco", {&effects_robot_comb, &effects_robot_ring, &effects_echo, NULL}},
+};
+
+static const effects_chain_t *effects_current = &effects_chains[0];
+
+uint32_t effects_chain_count(void)
+{
+    return sizeof(effects_chains) / sizeof(effects_chains[0]);
+}
+
+const char *effects_chain_name(uint32_t index)
+{
+    return index < effects_chain_count() ? effects_chains[index].name : "";
+}
+
+// Escolhe a cadeia e zera o estado das etapas; chamar com o áudio parado
+void effects_select(uint32_t index, uint32_t sample_rate)
+{
+    effects_current = &effects_chains[index < effects_chain_count() ? index : 0];
+    for (const effects_stage_t *const *stage = effects_current->stages; *stage; stage++)
+    {
+        (*stage)->reset((*stage)->state, sample_rate);
+    }
+}
+
+// Passa um bloco Q15 pelas etapas da cadeia escolhida, no lugar
+void effects_process(int16_t *block, uint32_t count)
+{
+    for (const effects_stage_t *const *stage = effects_current->stages; *stage; stage++)
+    {
+        (*stage)->process((*stage)->state, block, count);
+    }
+}
@@ -0,0 +1,34 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef effects_inc_h
+#define effects_inc_h
+
+#define EFFECTS_MAX_STAGES 3           // Etapas de uma cadeia
+#define EFFECTS_ECHO_BUFFER_SIZE 8192  // Linha do eco (potência de 2): 250 ms até 32 kHz
+#define EFFECTS_MOD_BUFFER_SIZE 1024   // Linha do coro/flanger (potência de 2): 30 ms até 32 kHz
+#define EFFECTS_COMB_BUFFER_SIZE 512   // Linha do filtro pente do robô (potência de 2)
+#define EFFECTS_NAME_LENGTH 8          // Caracteres do nome exibido no menu
+
+// Etapa da cadeia: processa um bloco Q15 no lugar, com estado pré-alocado (nenhum malloc)
+// reset recebe a taxa de amostragem para converter tempos e frequências em amostras
+typedef struct
+{
+    void (*reset)(void *state, uint32_t sample_rate);
+    void (*process)(void *state, int16_t *block, uint32_t count);
+    void *state;
+} effects_stage_t;
+
+// Cadeia registrada estaticamente: etapas em série, terminada por NULL
+typedef struct
+{
+    const char *name;
+    const effects_stage_t *stages[EFFECTS_MAX_STAGES + 1];
+} effects_chain_t;
+
+extern uint32_t effects_chain_count(void);
+extern const char *effects_chain_name(uint32_t index);
+extern void effects_select(uint32_t index, uint32_t sample_rate);
+extern void effects_process(int16_t *block, uint32_t count);
+
+#endif
@@ -0,0 +1,70 @@
+#include "event_queue.h"
+
+static event_t event_ring[EVENT_QUEUE_DEPTH];
+static volatile uint32_t event_head = 0; // Escrito só pelos produtores, com interrupções mascaradas
+static volatile uint32_t event_tail = 0; // Escrito só pelo consumidor
+static volatile uint32_t event_dropped_count = 0;
+
+void event_queue_init(void)
+{
+    event_head = 0;
+    event_tail = 0;
+    event_dropped_count = 0;
+}
+
+// Publica um evento; pode ser chamada de qualquer IRQ do núcleo 0 ou do laço principal
+// Com a fila cheia o evento é descartado e contado
+bool event_post(uint16_t type, uint16_t data)
+{
+    bool posted = false;
+    uint32_t irq = hal_irq_disable();
+
+    uint32_t head = event_head;
+    if (head - event_tail < EVENT_QUEUE_DEPTH)
+    {
+        event_ring[head & (EVENT_QUEUE_DEPTH - 1)] = (event_t){type, data};
+        event_head = head + 1; // Publicado depois de escrito: o consumidor nunca vê um evento pela metade
+        posted = true;
+    }
+    else
+    {
+        event_dropped_count++;
+    }
+
+    hal_irq_restore(irq);
+    return posted;
+}
+
+// Retira o evento mais antigo, se houver; só o laço principal consome
+bool event_poll(event_t *event)
+{
+    uint32_t tail = event_tail;
+    if (tail == event_head)
+    {
+        return false;
+    }
+    *event = event_ring[tail & (EVENT_QUEUE_DEPTH - 1)];
+    event_tail = tail + 1;
+    return true;
+}
+
+// Espera o próximo evento dormindo em WFI
+// A checagem da fila e o WFI acontecem com as interrupções mascaradas: uma IRQ que chegue no meio
+// fica pendente e acorda o WFI, então nenhum evento é perdido entre a checagem e o sono
+void event_wait(event_t *event)
+{
+    while (!event_poll(event))
+    {
+        uint32_t irq = hal_irq_disable();
+        if (event_head == event_tail)
+        {
+            hal_wait_for_interrupt();
+        }
+        hal_irq_restore(irq);
+    }
+}
+
+uint32_t event_queue_dropped(void)
+{
+    return event_dropped_count;
+}
@@ -0,0 +1,24 @@
+#include "hal.h"
+
+#ifndef event_queue_inc_h
+#define event_queue_inc_h
+
+#define EVENT_QUEUE_DEPTH 16 // Eventos pendentes (potência de 2)
+
+// Evento genérico: o significado de type e data é definido pela aplicação
+typedef struct
+{
+    uint16_t type;
+    uint16_t data;
+} event_t;
+
+// Fila circular de eventos: vários produtores (IRQs do núcleo 0) e um consumidor (laço principal)
+// O produtor reserva a posição com as interrupções mascaradas por poucas instruções, já que o M0+
+// não tem instruções atômicas; o consumidor não trava nada
+extern void event_queue_init(void);
+extern bool event_post(uint16_t type, uint16_t data);
+extern bool event_poll(event_t *event);
+extern void event_wait(event_t *event);
+extern uint32_t event_queue_dropped(void);
+
+#endif
@@ -0,0 +1,106 @@
+#include "fft.h"
+
+// Tabelas pré-calculadas para N = 128 (geradas com cos/sin em precisão dupla)
+// Fator de giro W^k = cos(2πk/N) - j·sin(2πk/N), k de 0 a N/2 - 1, em Q15
+static const int16_t fft_twiddle_cos[FFT_SIZE / 2] = {
+    32767, 32728, 32609, 32412, 32137, 31785, 31356, 30852, 30273, 29621, 28898, 28105,
+    27245, 26319, 25329, 24279, 23170, 22005, 20787, 19519, 18204, 16846, 15446, 14010,
+    12539, 11039, 9512, 7962, 6393, 4808, 3212, 1608, 0, -1608, -3212, -4808,
+    -6393, -7962, -9512, -11039, -12539, -14010, -15446, -16846, -18204, -19519, -20787, -22005,
+    -23170, -24279, -25329, -26319, -27245, -28105, -28898, -29621, -30273, -30852, -31356, -31785,
+    -32137, -32412, -32609, -32728,
+};
+
+static const int16_t fft_twiddle_sin[FFT_SIZE / 2] = {
+    0, 1608, 3212, 4808, 6393, 7962, 9512, 11039, 12539, 14010, 15446, 16846,
+    18204, 19519, 20787, 22005, 23170, 24279, 25329, 26319, 27245, 28105, 28898, 29621,
+    30273, 30852, 31356, 31785, 32137, 32412, 32609, 32728, 32767, 32728, 32609, 32412,
+    32137, 31785, 31356, 30852, 30273, 29621, 28898, 28105, 27245, 26319, 25329, 24279,
+    23170, 22005, 20787, 19519, 18204, 16846, 15446, 14010, 12539, 11039, 9512, 7962,
+    6393, 4808, 3212, 1608,
+};
+
+// Primeira metade da janela de Hann periódica em Q15, de w[0] a w[N/2] (w[N - n] = w[n])
+static const int16_t fft_hann_half[FFT_SIZE / 2 + 1] = {
+    0, 20, 79, 177, 315, 491, 705, 958, 1247, 1573, 1935, 2331,
+    2761, 3224, 3719, 4244, 4799, 5381, 5990, 6624, 7281, 7961, 8660, 9379,
+    10114, 10864, 11628, 12403, 13187, 13980, 14778, 15580, 16383, 17187, 17989, 18787,
+    19580, 20364, 21139, 21903, 22653, 23388, 24107, 24806, 25486, 26143, 26777, 27386,
+    27968, 28523, 29048, 29543, 30006, 30436, 30832, 31194, 31520, 31809, 32062, 32276,
+    32452, 32590, 32688, 32747, 32767,
+};
+
+// Permutação de bits invertidos dos índices de 7 bits
+static const uint8_t fft_bit_reverse[FFT_SIZE] = {
+    0, 64, 32, 96, 16, 80, 48, 112, 8, 72, 40, 104, 24, 88, 56, 120,
+    4, 68, 36, 100, 20, 84, 52, 116, 12, 76, 44, 108, 28, 92, 60, 124,
+    2, 66, 34, 98, 18, 82, 50, 114, 10, 74, 42, 106, 26, 90, 58, 122,
+    6, 70, 38, 102, 22, 86, 54, 118, 14, 78, 46, 110, 30, 94, 62, 126,
+    1, 65, 33, 97, 17, 81, 49, 113, 9, 73, 41, 105, 25, 89, 57, 121,
+    5, 69, 37, 101, 21, 85, 53, 117, 13, 77, 45, 109, 29, 93, 61, 125,
+    3, 67, 35, 99, 19, 83, 51, 115, 11, 75, 43, 107, 27, 91, 59, 123,
+    7, 71, 39, 103, 23, 87, 55, 119, 15, 79, 47, 111, 31, 95, 63, 127,
+};
+
+void fft_window_q15(int16_t *samples)
+{
+    for (int i = 0; i <= FFT_SIZE / 2; i++)
+    {
+        samples[i] = ((int32_t)samples[i] * fft_hann_half[i]) >> 15;
+    }
+    for (int i = 1; i < FFT_SIZE / 2; i++)
+    {
+        samples[FFT_SIZE - i] = ((int32_t)samples[FFT_SIZE - i] * fft_hann_half[i]) >> 15;
+    }
+}
+
+void fft_q15(int16_t *re, int16_t *im)
+{
+    // Reordena a entrada em ordem de bits invertidos (decimação no tempo)
+    for (int i = 0; i < FFT_SIZE; i++)
+    {
+        int j = fft_bit_reverse[i];
+        if (j > i)
+        {
+            int16_t t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    // Borboletas: multiplicações 16x16 -> 32 bits, que o M0+ faz em um ciclo
+    for (int half = 1, step = FFT_SIZE / 2; half < FFT_SIZE; half <<= 1, step >>= 1)
+    {
+        for (int j = 0; j < half; j++)
+        {
+            int32_t wr = fft_twiddle_cos[j * step];
+            int32_t wi = fft_twiddle_sin[j * step];
+
+            for (int a = j; a < FFT_SIZE; a += 2 * half)
+            {
+                int b = a + half;
+                int32_t tr = (re[b] * wr + im[b] * wi) >> 15;
+                int32_t ti = (im[b] * wr - re[b] * wi) >> 15;
+                int32_t ar = re[a];
+                int32_t ai = im[a];
+
+                re[a] = (ar + tr) >> 1;
+                im[a] = (ai + ti) >> 1;
+                re[b] = (ar - tr) >> 1;
+                im[b] = (ai - ti) >> 1;
+            }
+        }
+    }
+}
+
+uint32_t fft_magnitude(int16_t re, int16_t im)
+{
+    uint32_t x = re < 0 ? -re : re;
+    uint32_t y = im < 0 ? -im : im;
+    uint32_t max = x > y ? x : y;
+    uint32_t min = x > y ? y : x;
+    return max + ((3 * min) >> 3);
+}
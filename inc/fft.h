@@ -0,0 +1,20 @@
+#include <stdint.h>
+
+#ifndef fft_inc_h
+#define fft_inc_h
+
+#define FFT_SIZE_BITS 7                // FFT de 128 pontos (64 bins úteis)
+#define FFT_SIZE (1 << FFT_SIZE_BITS)
+#define FFT_BINS (FFT_SIZE / 2)
+
+// FFT radix-2 em ponto fixo Q15, no lugar (re e im com FFT_SIZE amostras)
+// Cada estágio divide por 2, então a saída vem escalada por 1/FFT_SIZE e nunca satura
+extern void fft_q15(int16_t *re, int16_t *im);
+
+// Aplica a janela de Hann (Q15) a FFT_SIZE amostras, no lugar
+extern void fft_window_q15(int16_t *samples);
+
+// Módulo aproximado de um bin (max + 3/8 min, erro < 7%), sem raiz quadrada
+extern uint32_t fft_magnitude(int16_t re, int16_t im);
+
+#endif
@@ -0,0 +1,358 @@
+#include <string.h>
+#include "flash_store.h"
+
+#define FLASH_STORE_MAGIC 0xA55B // Muda junto com o layout do registro; registros antigos deixam de valer
+#define FLASH_STORE_RECORDS_PER_SECTOR (FLASH_STORE_SECTOR_SIZE / sizeof(flash_store_record_t))
+#define FLASH_STORE_DATA_START (FLASH_STORE_INDEX_SECTORS * FLASH_STORE_SECTOR_SIZE)
+
+// Layout da região: [setores do índice][log de dados, usado em ordem e reiniciado no começo ao chegar no fim]
+// Cada gravação começa num setor novo (cabeça do log) e os setores à frente da cabeça são apagados
+// com antecedência, quando o áudio está parado; durante a gravação só há programação de páginas
+
+static const flash_store_ops_t *store_ops = NULL;
+static flash_store_record_t store_slots[FLASH_STORE_SLOTS]; // Registro vigente de cada slot
+static uint32_t store_sequence = 0;                         // Último número de sequência usado
+static uint32_t store_index_sector = 0;                     // Setor do índice em uso
+static uint32_t store_index_count = 0;                      // Registros já gravados nele
+static uint32_t store_head = FLASH_STORE_DATA_START;        // Início da próxima gravação
+static uint32_t store_erased = 0;                           // Bytes já apagados a partir da cabeça
+static uint32_t store_erase_ahead = 0;                      // Bytes que devem ficar apagados à frente
+static uint8_t store_page[FLASH_STORE_PAGE_SIZE];           // Página em montagem
+
+// Gravação em andamento
+static bool store_writing = false;
+static uint8_t store_write_slot;
+static uint8_t store_write_format;
+static uint32_t store_write_rate;
+static uint32_t store_write_offset; // Bytes já programados (páginas completas)
+static uint32_t store_page_fill;    // Bytes na página em montagem
+
+static uint32_t flash_store_align_sector(uint32_t bytes)
+{
+    return (bytes + FLASH_STORE_SECTOR_SIZE - 1) & ~(FLASH_STORE_SECTOR_SIZE - 1);
+}
+
+static uint32_t flash_store_record_check(const flash_store_record_t *record)
+{
+    return (record->magic ^ record->slot ^ (record->format << 8) ^ record->sequence ^
+            record->offset ^ record->length ^ record->bytes ^ record->rate) + 0x5A5A5A5A;
+}
+
+static bool flash_store_record_valid(const flash_store_record_t *record)
+{
+    return record->magic == FLASH_STORE_MAGIC && record->slot < FLASH_STORE_SLOTS &&
+           record->check == flash_store_record_check(record);
+}
+
+static bool flash_store_sector_blank(uint32_t offset)
+{
+    const uint32_t *words = (const uint32_t *)(store_ops->base + offset);
+    for (uint32_t i = 0; i < FLASH_STORE_SECTOR_SIZE / 4; i++)
+    {
+        if (words[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Programa um trecho qualquer usando páginas completas; o restante da página vai como 0xFF (não altera a flash)
+static void flash_store_program_bytes(uint32_t offset, const uint8_t *data, uint32_t count)
+{
+    while (count > 0)
+    {
+        uint32_t page = offset & ~(FLASH_STORE_PAGE_SIZE - 1);
+        uint32_t start = offset - page;
+        uint32_t chunk = FLASH_STORE_PAGE_SIZE - start;
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+        memset(store_page, 0xFF, FLASH_STORE_PAGE_SIZE);
+        memcpy(store_page + start, data, chunk);
+        store_ops->program_page(page, store_page);
+        offset += chunk;
+        data += chunk;
+        count -= chunk;
+    }
+}
+
+// Acrescenta um registro ao setor do índice em uso (sem compactar), com a sequência que ele já tem
+static void flash_store_append_record(flash_store_record_t *record)
+{
+    record->magic = FLASH_STORE_MAGIC;
+    record->check = flash_store_record_check(record);
+
+    uint32_t offset = store_index_sector * FLASH_STORE_SECTOR_SIZE + store_index_count * sizeof(flash_store_record_t);
+    flash_store_program_bytes(offset, (const uint8_t *)record, sizeof(flash_store_record_t));
+    store_index_count++;
+    store_slots[record->slot] = *record;
+}
+
+// Grava um registro; com o setor cheio, copia os slots vigentes para o outro setor do índice
+static void flash_store_commit_record(flash_store_record_t *record)
+{
+    if (store_index_count >= FLASH_STORE_RECORDS_PER_SECTOR)
+    {
+        store_index_sector = (store_index_sector + 1) % FLASH_STORE_INDEX_SECTORS;
+        store_index_count = 0;
+        store_ops->erase_sector(store_index_sector * FLASH_STORE_SECTOR_SIZE);
+
+        // As cópias mantêm a sequência original: a montagem acha a cabeça do log pela gravação de maior
+        // sequência, e uma cópia renumerada de uma gravação antiga a puxaria para trás
+        // O setor antigo pode ficar como está; se a compactação for interrompida, ele ainda vale inteiro
+        for (uint8_t slot = 0; slot < FLASH_STORE_SLOTS; slot++)
+        {
+            if (slot != record->slot && store_slots[slot].length > 0)
+            {
+                flash_store_record_t copy = store_slots[slot];
+                flash_store_append_record(&copy);
+            }
+        }
+    }
+    record->sequence = ++store_sequence;
+    flash_store_append_record(record);
+}
+
+// Marca como vazio todo slot cujos dados ocupam o setor que vai ser reaproveitado
+static void flash_store_evict(uint32_t sector)
+{
+    for (uint8_t slot = 0; slot < FLASH_STORE_SLOTS; slot++)
+    {
+        const flash_store_record_t *current = &store_slots[slot];
+        if (current->length > 0 && sector >= current->offset && sector < current->offset + current->bytes)
+        {
+            flash_store_record_t empty = {.slot = slot};
+            flash_store_commit_record(&empty);
+        }
+    }
+}
+
+// Volta a cabeça para o início do log se a janela apagada não couber até o fim da região
+static void flash_store_wrap_head(void)
+{
+    if (store_head + store_erase_ahead > store_ops->size)
+    {
+        store_head = FLASH_STORE_DATA_START;
+        store_erased = 0;
+    }
+}
+
+// Lê o índice da flash e prepara o log; erase_ahead é o maior tamanho de gravação em bytes
+bool flash_store_mount(const flash_store_ops_t *ops, uint32_t erase_ahead)
+{
+    store_ops = ops;
+    store_erase_ahead = flash_store_align_sector(erase_ahead);
+    store_writing = false;
+    if (!ops || ops->size < FLASH_STORE_DATA_START + store_erase_ahead)
+    {
+        store_ops = NULL;
+        return false;
+    }
+
+    memset(store_slots, 0, sizeof(store_slots));
+    store_sequence = 0;
+    store_index_sector = 0;
+    store_index_count = 0;
+
+    uint32_t head_end = FLASH_STORE_DATA_START;
+    uint32_t head_sequence = 0;
+    uint32_t sector_count[FLASH_STORE_INDEX_SECTORS];
+    for (uint32_t sector = 0; sector < FLASH_STORE_INDEX_SECTORS; sector++)
+    {
+        const flash_store_record_t *records = (const flash_store_record_t *)(ops->base + sector * FLASH_STORE_SECTOR_SIZE);
+        uint32_t count = 0;
+        while (count < FLASH_STORE_RECORDS_PER_SECTOR && records[count].magic != 0xFFFF)
+        {
+            const flash_store_record_t *record = &records[count++];
+            if (!flash_store_record_valid(record))
+            {
+                continue;
+            }
+            if (record->sequence > store_slots[record->slot].sequence)
+            {
+                store_slots[record->slot] = *record;
+            }
+            if (record->sequence > store_sequence)
+            {
+                store_sequence = record->sequence;
+                store_index_sector = sector;
+            }
+            // A cabeça do log fica logo depois da gravação mais recente
+            if (record->length > 0 && record->sequence > head_sequence)
+            {
+                head_sequence = record->sequence;
+                head_end = record->offset + flash_store_align_sector(record->bytes);
+            }
+        }
+        sector_count[sector] = count;
+    }
+    store_index_count = sector_count[store_index_sector];
+
+    // Setor do índice sem nenhum registro válido mas com lixo: apaga
+    if (store_sequence == 0 && !flash_store_sector_blank(0))
+    {
+        ops->erase_sector(0);
+        store_index_count = 0;
+    }
+
+    store_head = head_end;
+    store_erased = 0;
+    flash_store_wrap_head();
+
+    // Completa a janela apagada à frente da cabeça
+    while (flash_store_service())
+    {
+    }
+    return true;
+}
+
+// Avança a janela apagada em um setor; retorna false se não havia nada a fazer
+// Apagar um setor bloqueia a flash por dezenas de ms, então só deve ser chamada com o áudio parado
+bool flash_store_service(void)
+{
+    if (!store_ops || store_writing || store_erased >= store_erase_ahead)
+    {
+        return false;
+    }
+
+    uint32_t sector = store_head + store_erased;
+    flash_store_evict(sector);
+    if (!flash_store_sector_blank(sector))
+    {
+        store_ops->erase_sector(sector);
+    }
+    store_erased += FLASH_STORE_SECTOR_SIZE;
+    return true;
+}
+
+// Começa uma gravação no slot, na cabeça do log; falha se a janela ainda não está toda apagada
+bool flash_store_begin(uint8_t slot, uint8_t format, uint32_t rate)
+{
+    if (!store_ops || store_writing || slot >= FLASH_STORE_SLOTS || store_erased < store_erase_ahead)
+    {
+        return false;
+    }
+    store_writing = true;
+    store_write_slot = slot;
+    store_write_format = format;
+    store_write_rate = rate;
+    store_write_offset = 0;
+    store_page_fill = 0;
+    return true;
+}
+
+// Acrescenta bytes à gravação; cada página completa é programada na hora
+void flash_store_write(const uint8_t *data, uint32_t count)
+{
+    while (store_writing && count > 0)
+    {
+        if (store_write_offset + FLASH_STORE_PAGE_SIZE > store_erased)
+        {
+            return; // Janela apagada cheia: o restante fica só na RAM
+        }
+
+        uint32_t chunk = FLASH_STORE_PAGE_SIZE - store_page_fill;
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+        memcpy(store_page + store_page_fill, data, chunk);
+        store_page_fill += chunk;
+        data += chunk;
+        count -= chunk;
+
+        if (store_page_fill == FLASH_STORE_PAGE_SIZE)
+        {
+            store_ops->program_page(store_head + store_write_offset, store_page);
+            store_write_offset += FLASH_STORE_PAGE_SIZE;
+            store_page_fill = 0;
+        }
+    }
+}
+
+// Fecha a gravação: programa a última página, registra o slot no índice e avança a cabeça
+void flash_store_finish(uint32_t length, uint32_t bytes)
+{
+    if (!store_writing)
+    {
+        return;
+    }
+
+    if (store_page_fill > 0 && store_write_offset + FLASH_STORE_PAGE_SIZE <= store_erased)
+    {
+        memset(store_page + store_page_fill, 0xFF, FLASH_STORE_PAGE_SIZE - store_page_fill);
+        store_ops->program_page(store_head + store_write_offset, store_page);
+        store_write_offset += FLASH_STORE_PAGE_SIZE;
+    }
+    store_writing = false;
+
+    // Se a janela encheu antes do fim, guarda só o que foi programado
+    if (bytes > store_write_offset)
+    {
+        length = (uint64_t)length * store_write_offset / bytes;
+        bytes = store_write_offset;
+    }
+
+    flash_store_record_t record = {
+        .slot = store_write_slot,
+        .format = store_write_format,
+        .offset = store_head,
+        .length = length,
+        .bytes = bytes,
+        .rate = store_write_rate};
+    flash_store_commit_record(&record);
+
+    uint32_t used = flash_store_align_sector(store_write_offset);
+    store_head += used;
+    store_erased -= used;
+    flash_store_wrap_head();
+}
+
+// Descarta a gravação em andamento; as páginas já programadas são puladas
+void flash_store_abort(void)
+{
+    if (!store_writing)
+    {
+        return;
+    }
+    store_writing = false;
+
+    uint32_t used = flash_store_align_sector(store_write_offset + store_page_fill);
+    store_head += used;
+    store_erased -= used;
+    flash_store_wrap_head();
+}
+
+bool flash_store_is_writing(void)
+{
+    return store_writing;
+}
+
+// Amostras guardadas no slot (0 se vazio)
+uint32_t flash_store_slot_length(uint8_t slot)
+{
+    return store_ops && slot < FLASH_STORE_SLOTS ? store_slots[slot].length : 0;
+}
+
+uint8_t flash_store_slot_format(uint8_t slot)
+{
+    return slot < FLASH_STORE_SLOTS ? store_slots[slot].format : 0;
+}
+
+// Taxa de amostragem com que o slot foi gravado
+uint32_t flash_store_slot_rate(uint8_t slot)
+{
+    return slot < FLASH_STORE_SLOTS ? store_slots[slot].rate : 0;
+}
+
+// Ponteiro para os dados do slot, lidos direto da flash (XIP), sem cópia para RAM
+const uint8_t *flash_store_slot_data(uint8_t slot)
+{
+    if (!flash_store_slot_length(slot))
+    {
+        return NULL;
+    }
+    return store_ops->base + store_slots[slot].offset;
+}
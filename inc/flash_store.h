@@ -0,0 +1,48 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef flash_store_inc_h
+#define flash_store_inc_h
+
+#define FLASH_STORE_SECTOR_SIZE 4096u // Menor unidade de apagamento
+#define FLASH_STORE_PAGE_SIZE 256u    // Menor unidade de gravação
+#define FLASH_STORE_SLOTS 4           // Gravações guardadas ao mesmo tempo
+#define FLASH_STORE_INDEX_SECTORS 2   // Setores do índice (alternados na compactação)
+
+// Operações da memória flash; a região começa no offset 0 e pode ser lida diretamente por base
+// No RP2040 base aponta para o XIP; no host pode ser um vetor em RAM fazendo papel de flash
+typedef struct
+{
+    void (*erase_sector)(uint32_t offset);                      // Apaga FLASH_STORE_SECTOR_SIZE bytes (vira 0xFF)
+    void (*program_page)(uint32_t offset, const uint8_t *data); // Grava FLASH_STORE_PAGE_SIZE bytes (só 1 -> 0)
+    const uint8_t *base;
+    uint32_t size; // Bytes da região (múltiplo do setor)
+} flash_store_ops_t;
+
+// Registro do índice: cada gravação (ou invalidação) de slot acrescenta um registro novo
+typedef struct
+{
+    uint16_t magic;
+    uint8_t slot;
+    uint8_t format;    // audio_store_format_t da gravação
+    uint32_t sequence; // Ordem dos registros; o maior de cada slot vale
+    uint32_t offset;   // Início dos dados na região (alinhado ao setor)
+    uint32_t length;   // Amostras; 0 = slot vazio
+    uint32_t bytes;    // Bytes ocupados pelos dados
+    uint32_t rate;     // Taxa de amostragem da gravação (Hz)
+    uint32_t check;    // Soma de verificação (detecta registro gravado pela metade)
+} flash_store_record_t;
+
+extern bool flash_store_mount(const flash_store_ops_t *ops, uint32_t erase_ahead);
+extern bool flash_store_service(void);
+extern bool flash_store_begin(uint8_t slot, uint8_t format, uint32_t rate);
+extern void flash_store_write(const uint8_t *data, uint32_t count);
+extern void flash_store_finish(uint32_t length, uint32_t bytes);
+extern void flash_store_abort(void);
+extern bool flash_store_is_writing(void);
+extern uint32_t flash_store_slot_length(uint8_t slot);
+extern uint8_t flash_store_slot_format(uint8_t slot);
+extern uint32_t flash_store_slot_rate(uint8_t slot);
+extern const uint8_t *flash_store_slot_data(uint8_t slot);
+
+#endif
@@ -0,0 +1,68 @@
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "flash_store_pico.h"
+
+#define FLASH_STORE_REGION_SIZE (1024 * 1024) // Último 1 MB da flash QSPI, acima do firmware
+#define FLASH_STORE_REGION_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_STORE_REGION_SIZE)
+#define FLASH_STORE_TIMEOUT_MS 100
+
+static_assert(FLASH_STORE_SECTOR_SIZE == FLASH_SECTOR_SIZE, "setor da flash_store difere do hardware");
+static_assert(FLASH_STORE_PAGE_SIZE == FLASH_PAGE_SIZE, "página da flash_store difere do hardware");
+
+// Fim do firmware na flash, definido pelo linker script
+extern char __flash_binary_end;
+
+typedef struct
+{
+    uint32_t offset;
+    const uint8_t *data;
+} flash_store_pico_op_t;
+
+// Executadas por flash_safe_execute, com interrupções desligadas e o outro núcleo parado fora da flash
+static void flash_store_pico_do_erase(void *param)
+{
+    const flash_store_pico_op_t *op = param;
+    flash_range_erase(FLASH_STORE_REGION_OFFSET + op->offset, FLASH_SECTOR_SIZE);
+}
+
+static void flash_store_pico_do_program(void *param)
+{
+    const flash_store_pico_op_t *op = param;
+    flash_range_program(FLASH_STORE_REGION_OFFSET + op->offset, op->data, FLASH_PAGE_SIZE);
+}
+
+static void flash_store_pico_erase_sector(uint32_t offset)
+{
+    flash_store_pico_op_t op = {offset, NULL};
+    if (flash_safe_execute(flash_store_pico_do_erase, &op, FLASH_STORE_TIMEOUT_MS) != PICO_OK)
+    {
+        printf("Erro: falha ao apagar setor da flash.\n");
+    }
+}
+
+static void flash_store_pico_program_page(uint32_t offset, const uint8_t *data)
+{
+    flash_store_pico_op_t op = {offset, data};
+    if (flash_safe_execute(flash_store_pico_do_program, &op, FLASH_STORE_TIMEOUT_MS) != PICO_OK)
+    {
+        printf("Erro: falha ao gravar pagina da flash.\n");
+    }
+}
+
+static const flash_store_ops_t flash_store_pico = {
+    .erase_sector = flash_store_pico_erase_sector,
+    .program_page = flash_store_pico_program_page,
+    .base = (const uint8_t *)(XIP_BASE + FLASH_STORE_REGION_OFFSET), // Leitura direta pelo XIP
+    .size = FLASH_STORE_REGION_SIZE};
+
+// Operações da flash do RP2040, ou NULL se o firmware invadir a região reservada
+const flash_store_ops_t *flash_store_pico_ops(void)
+{
+    if ((uintptr_t)&__flash_binary_end - XIP_BASE > FLASH_STORE_REGION_OFFSET)
+    {
+        printf("Erro: firmware sobrepoe a regiao de gravacoes na flash.\n");
+        return NULL;
+    }
+    return &flash_store_pico;
+}
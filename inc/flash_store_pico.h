@@ -0,0 +1,8 @@
+#include "flash_store.h"
+
+#ifndef flash_store_pico_inc_h
+#define flash_store_pico_inc_h
+
+extern const flash_store_ops_t *flash_store_pico_ops(void);
+
+#endif
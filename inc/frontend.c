@@ -0,0 +1,101 @@
+#include <string.h>
+#include "frontend.h"
+
+#define FRONTEND_DC_SHIFT 8 // Polo do bloqueio de DC em 1 - 2^-8
+
+void frontend_init(frontend_t *fe, uint32_t sample_rate)
+{
+    memset(fe, 0, sizeof(*fe));
+    fe->gain = FRONTEND_GAIN_ONE;
+    fe->gate_open = false;
+
+    // Decaimento por sub-bloco para a constante de tempo FRONTEND_RELEASE_MS nesta taxa
+    uint32_t samples = sample_rate * FRONTEND_RELEASE_MS / 1000;
+    fe->release = 32768 - (int32_t)(32768u * FRONTEND_SUBBLOCK / (samples > FRONTEND_SUBBLOCK ? samples : FRONTEND_SUBBLOCK + 1));
+}
+
+// Fim de um sub-bloco: atualiza envelope, portão e o ganho alvo, e prepara a rampa das próximas amostras
+static void frontend_update_gain(frontend_t *fe)
+{
+    if (fe->peak > fe->envelope)
+    {
+        fe->envelope = fe->peak; // Ataque imediato: a antecipação dá tempo para a rampa
+    }
+    else
+    {
+        fe->envelope = (fe->envelope * fe->release) >> 15;
+    }
+    fe->peak = 0;
+
+    bool opening = false;
+    if (fe->envelope >= FRONTEND_GATE_OPEN)
+    {
+        opening = !fe->gate_open;
+        fe->gate_open = true;
+    }
+    else if (fe->envelope < FRONTEND_GATE_CLOSE)
+    {
+        fe->gate_open = false;
+    }
+
+    int32_t target = 0;
+    if (fe->gate_open)
+    {
+        target = FRONTEND_TARGET * FRONTEND_GAIN_ONE / (fe->envelope > 0 ? fe->envelope : 1);
+        if (target > FRONTEND_MAX_GAIN)
+        {
+            target = FRONTEND_MAX_GAIN;
+        }
+    }
+
+    // Descer (ou abrir o portão) chega ao alvo dentro do sub-bloco; subir e fechar o portão são exponenciais lentas
+    int32_t difference = target - fe->gain;
+    if (opening || (fe->gate_open && difference < 0))
+    {
+        fe->gain_step = difference / FRONTEND_SUBBLOCK;
+    }
+    else
+    {
+        fe->gain_step = (difference - ((difference * fe->release) >> 15)) / FRONTEND_SUBBLOCK;
+        if (fe->gain_step == 0 && difference != 0)
+        {
+            fe->gain_step = difference > 0 ? 1 : -1; // Perto do alvo a exponencial vira rampa, senão o portão nunca fecha
+        }
+    }
+}
+
+// Processa um bloco de qualquer tamanho (in e out podem ser o mesmo buffer)
+// A saída sai atrasada FRONTEND_LOOKAHEAD amostras em relação à entrada
+void frontend_process(frontend_t *fe, const int16_t *in, int16_t *out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        // Bloqueio de DC: y = x - x[n-1] + (1 - 2^-8) y[n-1], com y guardado em Q8 (sem ciclo limite)
+        int32_t x = in[i];
+        fe->dc_acc += (x - fe->dc_previous) * 256; // Multiplicação: deslocar um negativo é indefinido
+        fe->dc_acc -= fe->dc_acc >> FRONTEND_DC_SHIFT;
+        fe->dc_previous = (int16_t)x;
+        int32_t y = fe->dc_acc >> 8;
+
+        // Linha de antecipação: sai a amostra de FRONTEND_LOOKAHEAD atrás e entra a nova
+        int32_t delayed = fe->delay[fe->delay_index];
+        fe->delay[fe->delay_index] = (int16_t)(y > INT16_MAX ? INT16_MAX : y < INT16_MIN ? INT16_MIN : y);
+        fe->delay_index = (fe->delay_index + 1) & (FRONTEND_LOOKAHEAD - 1);
+
+        int32_t magnitude = (y ^ (y >> 31)) - (y >> 31); // |y| sem desvio
+        if (magnitude > fe->peak)
+        {
+            fe->peak = magnitude;
+        }
+
+        int32_t v = (delayed * fe->gain) >> 12;
+        out[i] = (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+        fe->gain += fe->gain_step;
+
+        if (++fe->sub_count == FRONTEND_SUBBLOCK)
+        {
+            fe->sub_count = 0;
+            frontend_update_gain(fe);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef frontend_inc_h
+#define frontend_inc_h
+
+#define FRONTEND_LOOKAHEAD 32           // Atraso do sinal em relação ao envelope (potência de 2, ~2,7 ms a 12 kHz)
+#define FRONTEND_SUBBLOCK 8             // Amostras entre recálculos do ganho (rampa linear entre eles)
+#define FRONTEND_GAIN_ONE 4096          // Ganho 1,0 (Q12)
+#define FRONTEND_MAX_GAIN (16 * FRONTEND_GAIN_ONE - 1) // Até +24 dB para quem fala baixo (Q15 x ganho cabe em 32 bits)
+#define FRONTEND_TARGET 16384           // Pico desejado na saída (-6 dBFS)
+#define FRONTEND_GATE_OPEN 300          // Envelope que abre o portão de ruído (~ -40 dBFS)
+#define FRONTEND_GATE_CLOSE 150         // Envelope que fecha o portão (histerese de 6 dB)
+#define FRONTEND_RELEASE_MS 150         // Constante de tempo do envelope e da subida do ganho
+
+// Etapa de entrada do microfone, em Q15:
+// - Bloqueio de DC: passa-altas de um polo (~7 Hz a 12 kHz) com o resto da divisão guardado no acumulador
+// - AGC com antecipação: o envelope vê o sinal FRONTEND_LOOKAHEAD amostras antes do ganho ser aplicado,
+//   então o ganho já desceu quando o pico chega (ataque sem estourar) e sobe devagar (liberação)
+// - Portão de ruído: abaixo do limiar o ganho vai a zero devagar, acima volta junto com o ataque
+typedef struct
+{
+    int32_t dc_acc;      // Saída do bloqueio de DC em Q8 (guarda a fração)
+    int16_t dc_previous; // Última entrada
+    int16_t delay[FRONTEND_LOOKAHEAD];
+    uint32_t delay_index;
+    int32_t peak;        // Maior valor absoluto do sub-bloco em andamento
+    uint32_t sub_count;  // Amostras do sub-bloco em andamento
+    int32_t envelope;
+    int32_t release;     // Fator de decaimento do envelope por sub-bloco (Q15)
+    int32_t gain;        // Ganho aplicado agora (Q12)
+    int32_t gain_step;   // Variação do ganho por amostra até o fim do sub-bloco
+    bool gate_open;
+} frontend_t;
+
+extern void frontend_init(frontend_t *fe, uint32_t sample_rate);
+extern void frontend_process(frontend_t *fe, const int16_t *in, int16_t *out, uint32_t count);
+
+#endif
@@ -0,0 +1,92 @@
+#ifdef HAL_HOST
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#else
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#endif
+
+#ifndef hal_inc_h
+#define hal_inc_h
+
+// Camada fina entre os módulos portáveis e o hardware
+// No RP2040 cada função é só um apelido do Pico SDK; com HAL_HOST (build do host, pasta host/)
+// as mesmas chamadas são implementadas em host/hal_host.c e os módulos compilam sem o SDK
+
+#ifdef HAL_HOST
+
+typedef unsigned int uint;
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+extern uint32_t hal_irq_disable(void);
+extern void hal_irq_restore(uint32_t state);
+extern void hal_wait_for_interrupt(void);
+extern void hal_memory_barrier(void);
+
+// Sem contador de ciclos portável no host: um "ciclo" é um nanossegundo do relógio monotônico
+#define HAL_CYCLES_MASK 0xFFFFFFFFu
+extern void hal_cycles_init(void);
+extern uint32_t hal_cycles(void);
+extern uint32_t hal_cycles_hz(void);
+extern uint32_t hal_time_us(void);
+
+#else
+
+// Mascara as interrupções do núcleo atual e devolve o estado anterior
+static inline uint32_t hal_irq_disable(void)
+{
+    return save_and_disable_interrupts();
+}
+
+static inline void hal_irq_restore(uint32_t state)
+{
+    restore_interrupts(state);
+}
+
+// Dorme até a próxima interrupção (mesmo mascarada, uma IRQ pendente acorda o núcleo)
+static inline void hal_wait_for_interrupt(void)
+{
+    __wfi();
+}
+
+// Ordena os acessos à memória entre os dois núcleos
+static inline void hal_memory_barrier(void)
+{
+    __dmb();
+}
+
+// Contador de ciclos: SysTick do núcleo no clock do sistema, 24 bits
+// Intervalos medidos com (fim - início) & HAL_CYCLES_MASK valem até ~134 ms a 125 MHz
+#define HAL_CYCLES_MASK 0x00FFFFFFu
+
+static inline void hal_cycles_init(void)
+{
+    systick_hw->rvr = HAL_CYCLES_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // Habilitado, clock do processador, sem interrupção
+}
+
+// O SysTick conta para baixo; devolve uma contagem crescente
+static inline uint32_t hal_cycles(void)
+{
+    return HAL_CYCLES_MASK - systick_hw->cvr;
+}
+
+static inline uint32_t hal_cycles_hz(void)
+{
+    return clock_get_hz(clk_sys);
+}
+
+// Microssegundos desde o boot (TIMERAWL), para intervalos longos
+static inline uint32_t hal_time_us(void)
+{
+    return time_us_32();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+#include "joystick.h"
+#include "adc_scheduler.h"
+
+// Estado filtrado de um eixo, atualizado a cada bloco do ADC na IRQ do DMA
+typedef struct
+{
+    volatile int32_t filtered;  // Posição filtrada em Q8, relativa ao centro
+    volatile int8_t direction;  // -1, 0 ou +1, com histerese
+} joystick_axis_t;
+
+static joystick_axis_t joystick_x;
+static joystick_axis_t joystick_y;
+
+// Dizima o bloco para uma única média (~190 Hz), passa por um filtro de um polo e aplica a histerese
+static void joystick_axis_update(joystick_axis_t *axis, const uint16_t *samples, uint count)
+{
+    uint32_t sum = 0;
+    for (uint i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    // Média de 12 bits x 16 = posição de 8 bits em Q8
+    int32_t position = (int32_t)((sum << 4) / count) - (JOYSTICK_CENTER << 8);
+
+    // Filtro de um polo (1/4 por bloco): constante de tempo de ~20 ms
+    int32_t filtered = axis->filtered + ((position - axis->filtered) >> 2);
+    axis->filtered = filtered;
+
+    int32_t magnitude = (filtered < 0 ? -filtered : filtered) >> 8;
+    if (axis->direction == 0)
+    {
+        if (magnitude >= JOYSTICK_ENTER_THRESHOLD)
+        {
+            axis->direction = filtered > 0 ? 1 : -1;
+        }
+    }
+    else if (magnitude < JOYSTICK_EXIT_THRESHOLD || (filtered > 0) != (axis->direction > 0))
+    {
+        axis->direction = 0;
+    }
+}
+
+static void joystick_x_handler(const uint16_t *samples, uint count)
+{
+    joystick_axis_update(&joystick_x, samples, count);
+}
+
+static void joystick_y_handler(const uint16_t *samples, uint count)
+{
+    joystick_axis_update(&joystick_y, samples, count);
+}
+
+// Passa a receber os dois eixos do rodízio do ADC
+void joystick_init(uint x_channel, uint y_channel)
+{
+    adc_scheduler_set_handler(x_channel, joystick_x_handler);
+    adc_scheduler_set_handler(y_channel, joystick_y_handler);
+}
+
+// Posição filtrada (-128 a 127), com zona morta em volta do centro
+static int joystick_position(const joystick_axis_t *axis)
+{
+    int position = axis->filtered >> 8;
+    if (position > -JOYSTICK_DEADZONE && position < JOYSTICK_DEADZONE)
+    {
+        return 0;
+    }
+    return position;
+}
+
+int joystick_position_x(void)
+{
+    return joystick_position(&joystick_x);
+}
+
+int joystick_position_y(void)
+{
+    return joystick_position(&joystick_y);
+}
+
+// Direção de cada eixo: +1 para direita/cima, -1 para esquerda/baixo, 0 no centro
+int joystick_direction_x(void)
+{
+    return joystick_x.direction;
+}
+
+int joystick_direction_y(void)
+{
+    return joystick_y.direction;
+}
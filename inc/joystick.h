@@ -0,0 +1,17 @@
+#include "hal.h"
+
+#ifndef joystick_inc_h
+#define joystick_inc_h
+
+#define JOYSTICK_CENTER 128          // Leitura de 8 bits com o Joystick solto
+#define JOYSTICK_DEADZONE 12         // Distância do centro tratada como posição 0
+#define JOYSTICK_ENTER_THRESHOLD 90  // Distância do centro para o eixo contar como inclinado
+#define JOYSTICK_EXIT_THRESHOLD 60   // Distância abaixo da qual o eixo volta ao centro (histerese)
+
+extern void joystick_init(uint x_channel, uint y_channel);
+extern int joystick_position_x(void);
+extern int joystick_position_y(void);
+extern int joystick_direction_x(void);
+extern int joystick_direction_y(void);
+
+#endif
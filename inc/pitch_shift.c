@@ -0,0 +1,73 @@
+#include <string.h>
+#include "pitch_shift.h"
+
+#define PITCH_SHIFT_MASK (PITCH_SHIFT_BUFFER_SIZE - 1)
+#define PITCH_SHIFT_DELAY_MASK (((uint32_t)PITCH_SHIFT_WINDOW << 16) - 1)
+
+// Razão de frequência 2^(n/12) em Q16, de -12 a +12 semitons
+static const uint32_t pitch_ratio_q16[2 * PITCH_SHIFT_MAX_SEMITONES + 1] = {
+    32768, 34716, 36781, 38968, 41285, 43740, 46341, 49097, 52016, 55109, 58386, 61858,
+    65536,
+    69433, 73562, 77936, 82570, 87480, 92682, 98193, 104032, 110218, 116772, 123715, 131072};
+
+// Zera a linha de atraso e volta para o tom original
+void pitch_shift_init(pitch_shift_t *ps)
+{
+    memset(ps->delay_line, 0, sizeof(ps->delay_line));
+    ps->write_index = 0;
+    ps->delay = 0;
+    pitch_shift_set_semitones(ps, 0);
+}
+
+// Define o deslocamento em semitons (limitado a ±12)
+void pitch_shift_set_semitones(pitch_shift_t *ps, int semitones)
+{
+    if (semitones > PITCH_SHIFT_MAX_SEMITONES)
+    {
+        semitones = PITCH_SHIFT_MAX_SEMITONES;
+    }
+    else if (semitones < -PITCH_SHIFT_MAX_SEMITONES)
+    {
+        semitones = -PITCH_SHIFT_MAX_SEMITONES;
+    }
+    ps->semitones = semitones;
+    // Cabeça de leitura anda "razão" amostras enquanto a escrita anda 1: o atraso muda 1 - razão
+    ps->step = (uint32_t)65536 - pitch_ratio_q16[semitones + PITCH_SHIFT_MAX_SEMITONES];
+}
+
+// Lê a linha de atraso com interpolação linear e aplica a janela triangular do grão
+static inline int32_t pitch_shift_tap(const pitch_shift_t *ps, uint32_t delay_q16)
+{
+    uint32_t delay_int = delay_q16 >> 16;
+    int32_t frac = (delay_q16 >> 1) & 0x7FFF; // Q15
+    int32_t newer = ps->delay_line[(ps->write_index - delay_int) & PITCH_SHIFT_MASK];
+    int32_t older = ps->delay_line[(ps->write_index - delay_int - 1) & PITCH_SHIFT_MASK];
+    int32_t sample = newer + (((older - newer) * frac) >> 15);
+
+    // Janela triangular: 0 nas bordas do grão e 1.0 (Q15) no meio
+    int32_t distance = delay_int < PITCH_SHIFT_WINDOW / 2 ? delay_int : PITCH_SHIFT_WINDOW - delay_int;
+    int32_t gain = distance << (16 - PITCH_SHIFT_WINDOW_BITS);
+    return sample * gain;
+}
+
+// Processa um bloco de amostras Q15; in e out podem ser o mesmo buffer
+void pitch_shift_process(pitch_shift_t *ps, const int16_t *in, int16_t *out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ps->write_index = (ps->write_index + 1) & PITCH_SHIFT_MASK;
+        ps->delay_line[ps->write_index] = in[i];
+
+        if (ps->semitones == 0)
+        {
+            out[i] = in[i]; // Sem deslocamento não há por que atrasar o sinal
+            continue;
+        }
+
+        // As duas cabeças ficam a meio grão de distância; os ganhos triangulares somam 1.0
+        ps->delay = (ps->delay + ps->step) & PITCH_SHIFT_DELAY_MASK;
+        uint32_t delay_b = (ps->delay + ((uint32_t)PITCH_SHIFT_WINDOW << 15)) & PITCH_SHIFT_DELAY_MASK;
+        int32_t mixed = pitch_shift_tap(ps, ps->delay) + pitch_shift_tap(ps, delay_b);
+        out[i] = mixed >> 15;
+    }
+}
@@ -0,0 +1,27 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef pitch_shift_inc_h
+#define pitch_shift_inc_h
+
+#define PITCH_SHIFT_MAX_SEMITONES 12
+#define PITCH_SHIFT_WINDOW_BITS 9                              // Grão de 512 amostras (~43 ms a 12 kHz)
+#define PITCH_SHIFT_WINDOW (1 << PITCH_SHIFT_WINDOW_BITS)
+#define PITCH_SHIFT_BUFFER_SIZE (2 * PITCH_SHIFT_WINDOW)       // Linha de atraso (potência de 2)
+
+// Estado do deslocador de tom granular: linha de atraso com duas cabeças de leitura
+// defasadas de meio grão, cada uma com janela triangular, somando ganho constante (overlap-add)
+typedef struct
+{
+    int16_t delay_line[PITCH_SHIFT_BUFFER_SIZE]; // Amostras Q15
+    uint32_t write_index;
+    uint32_t delay;                              // Atraso da primeira cabeça em Q16 (amostras)
+    uint32_t step;                               // Variação do atraso por amostra em Q16 (1 - razão)
+    int semitones;
+} pitch_shift_t;
+
+extern void pitch_shift_init(pitch_shift_t *ps);
+extern void pitch_shift_set_semitones(pitch_shift_t *ps, int semitones);
+extern void pitch_shift_process(pitch_shift_t *ps, const int16_t *in, int16_t *out, uint32_t count);
+
+#endif
@@ -0,0 +1,183 @@
+#include <assert.h>
+#include <string.h>
+#include "resampler.h"
+#include "resampler_table.h"
+
+#define RESAMPLER_FRAC_BITS 16
+#define RESAMPLER_WEIGHT_SHIFT (RESAMPLER_FRAC_BITS - RESAMPLER_PHASE_BITS)
+#define RESAMPLER_SINC_SHIFT (15 + RESAMPLER_PHASE_BITS - RESAMPLER_SINC_BITS) // u -> índice da tabela
+
+// As tabelas são geradas para este filtro
+static_assert(RESAMPLER_TABLE_TAPS == RESAMPLER_TAPS, "resampler_table.h gerado para outro número de taps");
+static_assert(RESAMPLER_TABLE_PHASE_BITS == RESAMPLER_PHASE_BITS, "resampler_table.h gerado para outras fases");
+
+static uint32_t resampler_gcd(uint32_t a, uint32_t b)
+{
+    while (b)
+    {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Divisão com arredondamento para o inteiro mais próximo (denominador positivo)
+static int32_t resampler_div_round(int32_t num, int32_t den)
+{
+    return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+// Projeta as fases: seno cardinal com janela de Blackman, corte em 0,85 da menor das duas frequências de
+// Nyquist (acelerando, o corte desce junto para não dobrar o que passa da Nyquist da saída)
+// Tudo em ponto fixo a partir das tabelas de resampler_table.h: o corte escala o argumento do seno
+// cardinal protótipo (interpolado entre amostras de 1/64) e a janela já vem nas posições exatas dos taps
+// Cada fase é normalizada para ganho 1 em DC, senão a troca de fase apareceria como ruído
+static void resampler_design(resampler_t *r, uint32_t in_rate, uint32_t out_rate)
+{
+    const int half = RESAMPLER_TAPS / 2;
+    uint32_t cutoff = out_rate < in_rate ? (uint64_t)RESAMPLER_CUTOFF_Q15 * out_rate / in_rate : RESAMPLER_CUTOFF_Q15;
+
+    for (int phase = 0; phase <= RESAMPLER_PHASES; phase++)
+    {
+        int32_t taps[RESAMPLER_TAPS];
+        int32_t sum = 0;
+
+        // A saída fica entre as entradas half - 1 e half do histórico (atraso fixo de meio filtro)
+        // t em 1/RESAMPLER_PHASES de tap; u = corte * |t| sai em passos de 2^-(15 + RESAMPLER_PHASE_BITS)
+        for (int k = 0; k < RESAMPLER_TAPS; k++)
+        {
+            int32_t t = (k - (half - 1)) * RESAMPLER_PHASES - phase;
+            uint32_t distance = t < 0 ? -t : t;
+            if (distance >= (uint32_t)half * RESAMPLER_PHASES)
+            {
+                taps[k] = 0;
+                continue;
+            }
+
+            uint32_t u = cutoff * distance;
+            uint32_t index = u >> RESAMPLER_SINC_SHIFT;
+            int32_t frac = u & ((1u << RESAMPLER_SINC_SHIFT) - 1);
+            int32_t sinc = resampler_sinc[index] +
+                           (((resampler_sinc[index + 1] - resampler_sinc[index]) * frac) >> RESAMPLER_SINC_SHIFT);
+            taps[k] = (sinc * resampler_window[distance]) >> 15;
+            sum += taps[k];
+        }
+
+        int32_t total = 0;
+        for (int k = 0; k < RESAMPLER_TAPS; k++)
+        {
+            r->coeffs[phase][k] = (int16_t)resampler_div_round(taps[k] * 32767, sum);
+            total += r->coeffs[phase][k];
+        }
+        r->coeffs[phase][half - 1 + (phase >= RESAMPLER_PHASES / 2)] += 32767 - total; // Sobra do arredondamento no tap central
+    }
+}
+
+// Prepara a conversão de in_rate para out_rate (ex.: taxa da gravação x velocidade para a taxa de saída)
+void resampler_init(resampler_t *r, uint32_t in_rate, uint32_t out_rate)
+{
+    memset(r, 0, sizeof(*r));
+
+    uint32_t gcd = resampler_gcd(in_rate, out_rate);
+    in_rate /= gcd;
+    out_rate /= gcd;
+    // A fração é convertida para Q16 com phase << 16, então o denominador precisa caber em 16 bits
+    while (out_rate >= (1u << RESAMPLER_FRAC_BITS))
+    {
+        in_rate >>= 1;
+        out_rate >>= 1;
+    }
+
+    r->step_int = in_rate / out_rate;
+    r->step_rem = in_rate % out_rate;
+    r->out_rate = out_rate;
+    r->bypass = in_rate == out_rate;
+    if (!r->bypass)
+    {
+        resampler_design(r, in_rate, out_rate);
+    }
+}
+
+// Próxima amostra da fonte, lida em blocos de RESAMPLER_CHUNK
+static bool resampler_pull(resampler_t *r, resampler_source_t source)
+{
+    if (r->input_position == r->input_count)
+    {
+        r->input_count = r->ended ? 0 : source(r->input, RESAMPLER_CHUNK);
+        r->input_position = 0;
+        if (r->input_count < RESAMPLER_CHUNK)
+        {
+            r->ended = true;
+        }
+        if (r->input_count == 0)
+        {
+            return false;
+        }
+    }
+
+    int16_t sample = r->input[r->input_position++];
+    r->history[r->history_index] = sample;
+    r->history[r->history_index + RESAMPLER_TAPS] = sample;
+    r->history_index = (r->history_index + 1) & (RESAMPLER_TAPS - 1);
+    return true;
+}
+
+static int32_t resampler_dot(const int16_t *coeffs, const int16_t *x)
+{
+    int32_t acc = 0;
+    for (int k = 0; k < RESAMPLER_TAPS; k++)
+    {
+        acc += coeffs[k] * x[k];
+    }
+    return acc >> 15;
+}
+
+// Produz até count amostras na taxa de saída; retorna menos que count quando a fonte acaba
+uint32_t resampler_read(resampler_t *r, resampler_source_t source, int16_t *out, uint32_t count)
+{
+    if (r->bypass)
+    {
+        return source(out, count);
+    }
+
+    uint32_t n = 0;
+    while (n < count)
+    {
+        // Fase (Q16) da posição entre duas entradas: escolhe o par de fases vizinhas e interpola
+        uint32_t frac = (r->phase << RESAMPLER_FRAC_BITS) / r->out_rate;
+        uint32_t index = frac >> RESAMPLER_WEIGHT_SHIFT;
+        int32_t weight = (frac & ((1u << RESAMPLER_WEIGHT_SHIFT) - 1)) << (15 - RESAMPLER_WEIGHT_SHIFT);
+        const int16_t *x = &r->history[r->history_index]; // Da entrada mais antiga para a mais nova
+
+        int32_t a = resampler_dot(r->coeffs[index], x);
+        int32_t b = resampler_dot(r->coeffs[index + 1], x);
+        int32_t y = a + (((b - a) * weight) >> 15);
+        if (y > INT16_MAX)
+        {
+            y = INT16_MAX;
+        }
+        else if (y < INT16_MIN)
+        {
+            y = INT16_MIN;
+        }
+        out[n++] = (int16_t)y;
+
+        // Avança a posição de leitura pela razão exata e consome as entradas que ficaram para trás
+        uint32_t advance = r->step_int;
+        r->phase += r->step_rem;
+        if (r->phase >= r->out_rate)
+        {
+            r->phase -= r->out_rate;
+            advance++;
+        }
+        while (advance--)
+        {
+            if (!resampler_pull(r, source))
+            {
+                return n;
+            }
+        }
+    }
+    return n;
+}
@@ -0,0 +1,36 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef resampler_inc_h
+#define resampler_inc_h
+
+#define RESAMPLER_TAPS 16                         // Taps de cada fase (potência de 2)
+#define RESAMPLER_PHASE_BITS 5                    // 32 fases, com interpolação linear entre vizinhas
+#define RESAMPLER_PHASES (1 << RESAMPLER_PHASE_BITS)
+#define RESAMPLER_CHUNK 32                        // Amostras pedidas à fonte de cada vez
+
+// Fonte das amostras de entrada (Q15); retorna quantas escreveu, menos que count no fim do áudio
+typedef uint32_t (*resampler_source_t)(int16_t *samples, uint32_t count);
+
+// Reamostrador polifásico: a posição de leitura anda in_rate/out_rate amostras por saída, guardada
+// como fração exata (parte inteira + resto sobre out_rate), então a razão não acumula erro
+typedef struct
+{
+    int16_t coeffs[RESAMPLER_PHASES + 1][RESAMPLER_TAPS]; // Q15; a fase extra é a fração 1,0 (interpolação)
+    int16_t history[2 * RESAMPLER_TAPS];                  // Últimas entradas, duplicadas para leitura contínua
+    uint32_t history_index;
+    int16_t input[RESAMPLER_CHUNK];
+    uint32_t input_count;
+    uint32_t input_position;
+    uint32_t step_int;  // Parte inteira de in_rate/out_rate
+    uint32_t step_rem;  // Resto de in_rate/out_rate
+    uint32_t out_rate;  // Denominador da razão (já reduzida)
+    uint32_t phase;     // Fração da posição de leitura, de 0 a out_rate - 1
+    bool bypass;        // Razão 1:1: copia a fonte direto
+    bool ended;
+} resampler_t;
+
+extern void resampler_init(resampler_t *r, uint32_t in_rate, uint32_t out_rate);
+extern uint32_t resampler_read(resampler_t *r, resampler_source_t source, int16_t *out, uint32_t count);
+
+#endif
@@ -1,17 +1,34 @@
-#include "ssd1306_i2c.h"
-extern void calculate_render_area_buffer_length(struct render_area *area);
-extern void ssd1306_send_command(uint8_t cmd);
-extern void ssd1306_send_command_list(uint8_t *ssd, int number);
-extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
-extern void ssd1306_init();
-extern void ssd1306_scroll(bool set);
-extern void render_on_display(uint8_t *ssd, struct render_area *area);
-extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
-extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
-extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, bool inverted);
-extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string, bool inverted);
-extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
-extern void ssd1306_config(ssd1306_t *ssd);
-extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
-extern void ssd1306_send_data(ssd1306_t *ssd);
+#include "ssd1306_i2c.h"
+extern void calculate_render_area_buffer_length(struct render_area *area);
+extern void ssd1306_send_command(uint8_t cmd);
+extern void ssd1306_send_command_list(uint8_t *ssd, int number);
+extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
+extern void ssd1306_init();
+extern void ssd1306_scroll(bool set);
+extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern void ssd1306_invalidate();
+extern bool ssd1306_flush_busy();
+extern void ssd1306_flush_wait();
+extern bool render_changes_on_display_async(uint8_t *ssd, void (*done)(void));
+extern void render_changes_on_display(uint8_t *ssd);
+extern uint32_t ssd1306_bus_bytes();
+extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
+extern void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, ssd1306_draw_mode_t mode);
+extern void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_blit_glyph(uint8_t *ssd, int x, int y, const uint8_t *columns, int width, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, bool inverted);
+extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string, bool inverted);
+extern int ssd1306_text_width(const char *string);
+extern int ssd1306_draw_text(uint8_t *ssd, int x, int y, const char *string, ssd1306_draw_mode_t mode);
+extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+extern void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number);
+extern void ssd1306_config(ssd1306_t *ssd);
+extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+extern void ssd1306_send_data(ssd1306_t *ssd);
+extern void ssd1306_send_area(ssd1306_t *ssd, int x_0, int x_1, int page_0, int page_1);
+extern void ssd1306_blit(ssd1306_t *ssd, const uint8_t *bitmap, int x, int y, int width, int height);
+extern void ssd1306_draw_bitmap_at(ssd1306_t *ssd, const uint8_t *bitmap, int x, int y, int width, int height);
 extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include <string.h>
+#include <assert.h>
+#include "ssd1306.h"
+#include "ssd1306_font.h"
+
+// Primitivas de desenho sobre o framebuffer em RAM (páginas de 8 linhas, bit 0 = linha de cima)
+// Não tocam no barramento: o envio fica com ssd1306_i2c.c, ou com o substituto do build do host
+
+// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
+void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set)
+{
+    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
+
+    uint8_t *byte = &ssd[(y >> 3) * ssd1306_width + x];
+    uint8_t mask = 1u << (y & 7);
+
+    if (set)
+    {
+        *byte |= mask;
+    }
+    else
+    {
+        *byte &= ~mask;
+    }
+}
+
+// Aplica a máscara de bits a um byte do framebuffer conforme o modo de desenho
+static inline void ssd1306_apply_mask(uint8_t *byte, uint8_t mask, ssd1306_draw_mode_t mode)
+{
+    switch (mode)
+    {
+    case ssd1306_draw_set:
+        *byte |= mask;
+        break;
+    case ssd1306_draw_clear:
+        *byte &= ~mask;
+        break;
+    case ssd1306_draw_xor:
+        *byte ^= mask;
+        break;
+    }
+}
+
+// Máscara das linhas [y_0, y_1] (já recortadas) dentro da página page
+static inline uint8_t ssd1306_page_mask(int page, int y_0, int y_1)
+{
+    int top = y_0 - page * 8;
+    int bottom = y_1 - page * 8;
+    uint8_t mask = 0xFF;
+
+    if (top > 0)
+    {
+        mask &= 0xFF << top;
+    }
+    if (bottom < 7)
+    {
+        mask &= 0xFF >> (7 - bottom);
+    }
+    return mask;
+}
+
+// Linha horizontal de x_0 a x_1 (inclusive): um único bit por byte ao longo da página
+void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, ssd1306_draw_mode_t mode)
+{
+    if (x_0 > x_1)
+    {
+        int t = x_0;
+        x_0 = x_1;
+        x_1 = t;
+    }
+    if (y < 0 || y >= ssd1306_height || x_1 < 0 || x_0 >= ssd1306_width)
+    {
+        return;
+    }
+    if (x_0 < 0)
+        x_0 = 0;
+    if (x_1 > ssd1306_width - 1)
+        x_1 = ssd1306_width - 1;
+
+    uint8_t *byte = &ssd[(y >> 3) * ssd1306_width + x_0];
+    uint8_t mask = 1u << (y & 7);
+
+    for (int x = x_0; x <= x_1; x++)
+    {
+        ssd1306_apply_mask(byte++, mask, mode);
+    }
+}
+
+// Retângulo preenchido: cada página coberta recebe a mesma máscara em todas as colunas
+// Páginas inteiras nos modos set/clear viram um memset
+void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode)
+{
+    int x_0 = x < 0 ? 0 : x;
+    int x_1 = x + width - 1 > ssd1306_width - 1 ? ssd1306_width - 1 : x + width - 1;
+    int y_0 = y < 0 ? 0 : y;
+    int y_1 = y + height - 1 > ssd1306_height - 1 ? ssd1306_height - 1 : y + height - 1;
+
+    if (width <= 0 || height <= 0 || x_0 > x_1 || y_0 > y_1)
+    {
+        return;
+    }
+
+    for (int page = y_0 >> 3; page <= y_1 >> 3; page++)
+    {
+        uint8_t mask = ssd1306_page_mask(page, y_0, y_1);
+        uint8_t *byte = &ssd[page * ssd1306_width + x_0];
+
+        if (mask == 0xFF && mode != ssd1306_draw_xor)
+        {
+            memset(byte, mode == ssd1306_draw_set ? 0xFF : 0x00, x_1 - x_0 + 1);
+            continue;
+        }
+
+        for (int i = x_0; i <= x_1; i++)
+        {
+            ssd1306_apply_mask(byte++, mask, mode);
+        }
+    }
+}
+
+// Linha vertical de y_0 a y_1 (inclusive): um byte com máscara por página atravessada
+void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, ssd1306_draw_mode_t mode)
+{
+    ssd1306_fill_rect(ssd, x, y_0 < y_1 ? y_0 : y_1, 1, abs(y_1 - y_0) + 1, mode);
+}
+
+// Contorno de retângulo; os cantos são desenhados uma única vez para o modo XOR funcionar
+void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    ssd1306_draw_hline(ssd, x, x + width - 1, y, mode);
+    if (height > 1)
+    {
+        ssd1306_draw_hline(ssd, x, x + width - 1, y + height - 1, mode);
+    }
+    if (height > 2)
+    {
+        ssd1306_fill_rect(ssd, x, y + 1, 1, height - 2, mode);
+        if (width > 1)
+        {
+            ssd1306_fill_rect(ssd, x + width - 1, y + 1, 1, height - 2, mode);
+        }
+    }
+}
+
+// Copia um glifo de 8 linhas (um byte por coluna) para qualquer posição, recortando nas bordas
+// Com y fora da grade de páginas, cada coluna é dividida entre duas páginas por deslocamento
+// No modo set a célula do glifo é sobrescrita (fundo apagado); em clear/xor só os bits acesos atuam
+void ssd1306_blit_glyph(uint8_t *ssd, int x, int y, const uint8_t *columns, int width, ssd1306_draw_mode_t mode)
+{
+    if (y <= -8 || y >= ssd1306_height)
+    {
+        return;
+    }
+
+    const int shift = y & 7;
+    const int page = (y - shift) / 8; // Página do topo do glifo (-1 quando y é negativo)
+    uint8_t *upper = page >= 0 ? &ssd[page * ssd1306_width] : NULL;
+    uint8_t *lower = shift && page + 1 < (int)ssd1306_n_pages ? &ssd[(page + 1) * ssd1306_width] : NULL;
+    const uint8_t upper_cell = 0xFF << shift;
+    const uint8_t lower_cell = 0xFF >> (8 - shift);
+
+    for (int i = 0; i < width; i++)
+    {
+        int column = x + i;
+        if (column < 0 || column >= ssd1306_width)
+        {
+            continue;
+        }
+
+        uint16_t bits = columns[i] << shift;
+
+        if (upper)
+        {
+            if (mode == ssd1306_draw_set)
+            {
+                upper[column] = (upper[column] & ~upper_cell) | (bits & 0xFF);
+            }
+            else
+            {
+                ssd1306_apply_mask(&upper[column], bits & 0xFF, mode);
+            }
+        }
+        if (lower)
+        {
+            if (mode == ssd1306_draw_set)
+            {
+                lower[column] = (lower[column] & ~lower_cell) | (bits >> 8);
+            }
+            else
+            {
+                ssd1306_apply_mask(&lower[column], bits >> 8, mode);
+            }
+        }
+    }
+}
+
+// Algoritmo de Bresenham básico
+// Linhas horizontais e verticais vão direto para as rotinas de span
+void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set)
+{
+    if (y_0 == y_1)
+    {
+        ssd1306_draw_hline(ssd, x_0, x_1, y_0, set ? ssd1306_draw_set : ssd1306_draw_clear);
+        return;
+    }
+    if (x_0 == x_1)
+    {
+        ssd1306_draw_vline(ssd, x_0, y_0, y_1, set ? ssd1306_draw_set : ssd1306_draw_clear);
+        return;
+    }
+
+    int dx = abs(x_1 - x_0); // Deslocamentos
+    int dy = -abs(y_1 - y_0);
+    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
+    int sy = y_0 < y_1 ? 1 : -1;
+    int error = dx + dy; // Erro acumulado
+    int error_2;
+
+    while (true)
+    {
+        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
+        if (x_0 == x_1 && y_0 == y_1)
+        {
+            break; // Verifica se o ponto final foi alcançado
+        }
+
+        error_2 = 2 * error; // Ajusta o erro acumulado
+
+        if (error_2 >= dy)
+        {
+            error += dy;
+            x_0 += sx; // Avança na direção x
+        }
+        if (error_2 <= dx)
+        {
+            error += dx;
+            y_0 += sy; // Avança na direção y
+        }
+    }
+}
+
+// Posição da primeira coluna de um glifo no atlas (o nono bit vem de ssd1306_font_high_from)
+static inline int ssd1306_glyph_start(int glyph)
+{
+    return ssd1306_font_offset[glyph] + (glyph >= ssd1306_font_high_from ? 256 : 0);
+}
+
+// Adquire as colunas e a largura do glifo de um caractere (de acordo com ssd1306_font.h)
+// Acesso direto pelo código; caracteres fora do ASCII imprimível caem no glifo de '?'
+static inline const uint8_t *ssd1306_get_glyph(uint8_t character, int *width)
+{
+    int glyph = character >= ssd1306_font_first && character <= ssd1306_font_last
+                    ? character - ssd1306_font_first
+                    : ssd1306_font_fallback - ssd1306_font_first;
+    int start = ssd1306_glyph_start(glyph);
+    *width = ssd1306_glyph_start(glyph + 1) - start;
+    return &ssd1306_font_atlas[start];
+}
+
+// Desenha um único caractere numa célula fixa de 8x8, em qualquer y e recortado nas bordas
+// A célula é apagada e o glifo centralizado; a inversão é um XOR sobre a célula
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, bool inverted)
+{
+    int width;
+    const uint8_t *columns = ssd1306_get_glyph(character, &width);
+
+    ssd1306_fill_rect(ssd, x, y, 8, ssd1306_font_height, ssd1306_draw_clear);
+    ssd1306_blit_glyph(ssd, x + (8 - width) / 2, y, columns, width, ssd1306_draw_set);
+    if (inverted)
+    {
+        ssd1306_fill_rect(ssd, x, y, 8, ssd1306_font_height, ssd1306_draw_xor);
+    }
+}
+
+// Desenha uma string, chamando a função de desenhar caractere várias vezes (células fixas de 8 pixels)
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string, bool inverted)
+{
+    while (*string && x < ssd1306_width)
+    {
+        ssd1306_draw_char(ssd, x, y, *string++, inverted);
+        x += 8;
+    }
+}
+
+// Largura em pixels de um texto proporcional (uma coluna de espaço entre glifos)
+int ssd1306_text_width(const char *string)
+{
+    int width = 0;
+    int glyph_width;
+
+    while (*string)
+    {
+        ssd1306_get_glyph(*string++, &glyph_width);
+        width += glyph_width + 1;
+    }
+    return width > 0 ? width - 1 : 0;
+}
+
+// Desenha um texto proporcional no modo indicado e retorna o x logo após o último glifo
+int ssd1306_draw_text(uint8_t *ssd, int x, int y, const char *string, ssd1306_draw_mode_t mode)
+{
+    int width;
+
+    while (*string && x < ssd1306_width)
+    {
+        const uint8_t *columns = ssd1306_get_glyph(*string++, &width);
+        ssd1306_blit_glyph(ssd, x, y, columns, width, mode);
+        x += width + 1;
+    }
+    return x;
+}
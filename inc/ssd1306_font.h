@@ -1,77 +0,0 @@
-
-static uint8_t font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
-    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
-    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, // D
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, // E
-    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, // F
-    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, // G
-    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, // H
-    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // I
-    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, // J
-    0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, // K
-    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // L
-    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, // M
-    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, // N
-    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, // O
-    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, // P
-    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, // Q
-    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, // R
-    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // S
-    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, // T
-    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, // U
-    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, // V
-    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, // W
-    0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
-    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
-    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // Nothing (Inverted)
-    0x87, 0xEB, 0xED, 0xEE, 0xED, 0xEB, 0x87, 0xFF, // A (Inverted)
-    0x80, 0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0x80, 0xFF, // B (Inverted)
-    0x81, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xFF, // C (Inverted)
-    0x80, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0x81, 0xFF, // D (Inverted)
-    0x80, 0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0xFF, // E (Inverted)
-    0x80, 0xF6, 0xF6, 0xF6, 0xF6, 0xFE, 0xFE, 0xFF, // F (Inverted)
-    0x80, 0xBE, 0xBE, 0xBE, 0xAE, 0xAE, 0x8C, 0xFF, // G (Inverted)
-    0x80, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0x80, 0xFF, // H (Inverted)
-    0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, // I (Inverted)
-    0xDE, 0xBE, 0xBE, 0xC0, 0xFE, 0xFE, 0xFE, 0xFF, // J (Inverted)
-    0xFF, 0x80, 0xF7, 0xF7, 0xEB, 0xDD, 0xBE, 0xFF, // K (Inverted)
-    0x80, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xFF, // L (Inverted)
-    0x80, 0xFD, 0xFB, 0xF7, 0xFB, 0xFD, 0x80, 0xFF, // M (Inverted)
-    0x80, 0xFD, 0xFB, 0xF7, 0xEF, 0xDF, 0x80, 0xFF, // N (Inverted)
-    0xC1, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xC1, 0xFF, // O (Inverted)
-    0x80, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xF1, 0xFF, // P (Inverted)
-    0xC1, 0xBE, 0xBE, 0xB6, 0xAE, 0x9E, 0x81, 0xFF, // Q (Inverted)
-    0x80, 0xEE, 0xEE, 0xEE, 0xCE, 0xAE, 0xF1, 0xFF, // R (Inverted)
-    0xB9, 0xB6, 0xB6, 0xB6, 0xB6, 0xCF, 0xFF, 0xFF, // S (Inverted)
-    0xFE, 0xFE, 0xFE, 0x80, 0xFE, 0xFE, 0xFE, 0xFF, // T (Inverted)
-    0xC0, 0xBF, 0xBF, 0xBF, 0xBF, 0xBF, 0xC0, 0xFF, // U (Inverted)
-    0xF0, 0xEF, 0xDF, 0xBF, 0xDF, 0xEF, 0xF0, 0xFF, // V (Inverted)
-    0x80, 0xDF, 0xEF, 0xF7, 0xEF, 0xDF, 0x80, 0xFF, // W (Inverted)
-    0xFF, 0xBE, 0xDD, 0xEB, 0xEB, 0xDD, 0xBE, 0xFF, // X (Inverted)
-    0xFE, 0xFD, 0xFB, 0x87, 0xFB, 0xFD, 0xFE, 0xFF, // Y (Inverted)
-    0xBE, 0x9E, 0xA6, 0xBA, 0xBC, 0xBE, 0xFF, 0xFF, // Z (Inverted)
-    0xC1, 0xBE, 0xBE, 0xB6, 0xBE, 0xBE, 0xC1, 0xFF, // 0 (Inverted)
-    0xFF, 0xFF, 0xBD, 0x80, 0xBF, 0xFF, 0xFF, 0xFF, // 1 (Inverted)
-    0xCF, 0xB6, 0xB6, 0xB6, 0xB6, 0xB9, 0xFF, 0xFF, // 2 (Inverted)
-    0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0xC9, 0xFF, // 3 (Inverted)
-    0xC0, 0xDF, 0xDF, 0x87, 0xDF, 0xDF, 0xFF, 0xFF, // 4 (Inverted)
-    0xB0, 0xB6, 0xB6, 0xB6, 0xB6, 0xCF, 0xFF, 0xFF, // 5 (Inverted)
-    0xC0, 0xB7, 0xB7, 0xB7, 0xB7, 0xB7, 0xCF, 0xFF, // 6 (Inverted)
-    0xFE, 0xFE, 0xFE, 0x9E, 0xCE, 0xF2, 0xFC, 0xFF, // 7 (Inverted)
-    0xC9, 0xB6, 0xB6, 0xB6, 0xB6, 0xB6, 0xC9, 0xFF, // 8 (Inverted)
-    0xF9, 0xF6, 0xF6, 0xF6, 0xF6, 0xF6, 0x80, 0xFF  // 9 (Inverted)
-};
\ No newline at end of file
@@ -1,292 +1,494 @@
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-#include "hardware/i2c.h"
-#include "ssd1306_font.h"
-#include "ssd1306_i2c.h"
-
-// Calcular quanto do buffer será destinado à área de renderização
-void calculate_render_area_buffer_length(struct render_area *area)
-{
-    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
-}
-
-// Processo de escrita do i2c espera um byte de controle, seguido por dados
-void ssd1306_send_command(uint8_t command)
-{
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
-}
-
-// Envia uma lista de comandos ao hardware
-void ssd1306_send_command_list(uint8_t *ssd, int number)
-{
-    for (int i = 0; i < number; i++)
-    {
-        ssd1306_send_command(ssd[i]);
-    }
-}
-
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length)
-{
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
-}
-
-// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init()
-{
-    uint8_t commands[] = {
-        ssd1306_set_display,
-        ssd1306_set_memory_mode,
-        0x00,
-        ssd1306_set_display_start_line,
-        ssd1306_set_segment_remap | 0x01,
-        ssd1306_set_mux_ratio,
-        ssd1306_height - 1,
-        ssd1306_set_common_output_direction | 0x08,
-        ssd1306_set_display_offset,
-        0x00,
-        ssd1306_set_common_pin_configuration,
-
-#if ((ssd1306_width == 128) && (ssd1306_height == 32))
-        0x02,
-#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
-        0x12,
-#else
-        0x02,
-#endif
-        ssd1306_set_display_clock_divide_ratio,
-        0x80,
-        ssd1306_set_precharge,
-        0xF1,
-        ssd1306_set_vcomh_deselect_level,
-        0x30,
-        ssd1306_set_contrast,
-        0xFF,
-        ssd1306_set_entire_on,
-        ssd1306_set_normal_display,
-        ssd1306_set_charge_pump,
-        0x14,
-        ssd1306_set_scroll | 0x00,
-        ssd1306_set_display | 0x01,
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Cria a lista de comandos para configurar o scrolling
-void ssd1306_scroll(bool set)
-{
-    uint8_t commands[] = {
-        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
-        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)};
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Atualiza uma parte do display com uma área de renderização
-void render_on_display(uint8_t *ssd, struct render_area *area)
-{
-    uint8_t commands[] = {
-        ssd1306_set_column_address, area->start_column, area->end_column,
-        ssd1306_set_page_address, area->start_page, area->end_page};
-
-    ssd1306_send_command_list(commands, count_of(commands));
-    ssd1306_send_buffer(ssd, area->buffer_length);
-}
-
-// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
-void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set)
-{
-    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
-
-    const int bytes_per_row = ssd1306_width;
-
-    int byte_idx = (y / 8) * bytes_per_row + x;
-    uint8_t byte = ssd[byte_idx];
-
-    if (set)
-    {
-        byte |= 1 << (y % 8);
-    }
-    else
-    {
-        byte &= ~(1 << (y % 8));
-    }
-
-    ssd[byte_idx] = byte;
-}
-
-// Algoritmo de Bresenham básico
-void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set)
-{
-    int dx = abs(x_1 - x_0); // Deslocamentos
-    int dy = -abs(y_1 - y_0);
-    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
-    int sy = y_0 < y_1 ? 1 : -1;
-    int error = dx + dy; // Erro acumulado
-    int error_2;
-
-    while (true)
-    {
-        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
-        if (x_0 == x_1 && y_0 == y_1)
-        {
-            break; // Verifica se o ponto final foi alcançado
-        }
-
-        error_2 = 2 * error; // Ajusta o erro acumulado
-
-        if (error_2 >= dy)
-        {
-            error += dy;
-            x_0 += sx; // Avança na direção x
-        }
-        if (error_2 <= dx)
-        {
-            error += dx;
-            y_0 += sy; // Avança na direção y
-        }
-    }
-}
-
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-    if (character >= 'A' && character <= 'Z')
-    {
-        return character - 'A' + 1;
-    }
-    else if (character >= '0' && character <= '9')
-    {
-        return character - '0' + 27;
-    }
-    else
-        return 0;
-}
-
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character, bool inverted)
-{
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8)
-    {
-        return;
-    }
-
-    y = y / 8;
-
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    if (inverted)
-    {
-        idx += 37;
-    }
-    int fb_idx = y * 128 + x;
-
-    for (int i = 0; i < 8; i++)
-    {
-        ssd[fb_idx++] = font[idx * 8 + i];
-    }
-}
-
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
-void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string, bool inverted)
-{
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8)
-    {
-        return;
-    }
-
-    while (*string)
-    {
-        ssd1306_draw_char(ssd, x, y, *string++, inverted);
-        x += 8;
-    }
-}
-
-// Comando de configuração com base na estrutura ssd1306_t
-void ssd1306_command(ssd1306_t *ssd, uint8_t command)
-{
-    ssd->port_buffer[1] = command;
-    i2c_write_blocking(
-        ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
-}
-
-// Função de configuração do display para o caso do bitmap
-void ssd1306_config(ssd1306_t *ssd)
-{
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
-}
-
-// Inicializa o display para o caso de exibição de bitmap
-void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c)
-{
-    ssd->width = width;
-    ssd->height = height;
-    ssd->pages = height / 8U;
-    ssd->address = address;
-    ssd->i2c_port = i2c;
-    ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    ssd->ram_buffer[0] = 0x40;
-    ssd->port_buffer[0] = 0x80;
-}
-
-// Envia os dados ao display
-void ssd1306_send_data(ssd1306_t *ssd)
-{
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-        ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
-}
-
-// Desenha o bitmap (a ser fornecido em display_oled.c) no display
-void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap)
-{
-    for (int i = 0; i < ssd->bufsize - 1; i++)
-    {
-        ssd->ram_buffer[i + 1] = bitmap[i];
-
-        ssd1306_send_data(ssd);
-    }
-}
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "pico/binary_info.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306.h"
+#include "stats.h"
+
+// Envio assíncrono por DMA: as transações são montadas como palavras do registrador IC_DATA_CMD
+// (byte nos bits 7:0 e STOP no bit 9), então várias transações seguidas vão num único DMA
+// Pior caso: todas as páginas com comando (1 + 6 bytes) e dados (1 + 128 bytes)
+static uint16_t ssd1306_dma_words[ssd1306_n_pages * (7 + 1 + ssd1306_width)];
+static uint ssd1306_dma_count = 0;
+static int ssd1306_dma_chan = -1;
+static void (*ssd1306_dma_done)(void) = NULL;
+static uint32_t ssd1306_dma_start_us = 0;
+
+// Buffer persistente do envio bloqueante, com espaço para o byte de controle
+static uint8_t ssd1306_tx_buffer[ssd1306_buffer_length + 1];
+
+// Bytes colocados no barramento desde o boot (endereço + controle + dados de cada transação)
+static uint32_t ssd1306_bus_byte_count = 0;
+
+uint32_t ssd1306_bus_bytes()
+{
+    return ssd1306_bus_byte_count;
+}
+
+// Envio bloqueante de uma transação, contando os bytes que passam pelo barramento
+static void ssd1306_write_blocking(i2c_inst_t *i2c, uint8_t address, const uint8_t *bytes, size_t length, bool nostop)
+{
+    uint32_t start = stats_begin();
+    ssd1306_bus_byte_count += length + 1;
+    i2c_write_blocking(i2c, address, bytes, length, nostop);
+    stats_end(STATS_DISPLAY_BUS, start);
+}
+
+// Interrupção de fim do DMA: todas as palavras já estão no FIFO do I2C
+static void ssd1306_dma_irq_handler(void)
+{
+    if (ssd1306_dma_chan >= 0 && dma_channel_get_irq0_status(ssd1306_dma_chan))
+    {
+        dma_channel_acknowledge_irq0(ssd1306_dma_chan);
+        // Os últimos bytes ainda estão no FIFO (até 16, ~0,4 ms a 400 kHz), fora da medida
+        stats_end(STATS_DISPLAY_BUS, ssd1306_dma_start_us);
+        if (ssd1306_dma_done)
+        {
+            ssd1306_dma_done();
+        }
+    }
+}
+
+// Reserva o canal DMA do display (uma única vez)
+static void ssd1306_dma_init()
+{
+    if (ssd1306_dma_chan >= 0)
+    {
+        return;
+    }
+    ssd1306_dma_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(ssd1306_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16); // Palavra do IC_DATA_CMD
+    channel_config_set_read_increment(&cfg, true);            // Leitura incremental (palavras montadas)
+    channel_config_set_write_increment(&cfg, false);          // Escrita fixa (IC_DATA_CMD)
+    channel_config_set_dreq(&cfg, i2c_get_dreq(i2c1, true));  // Ritmo do FIFO de transmissão do I2C
+    dma_channel_set_config(ssd1306_dma_chan, &cfg, false);
+    dma_channel_set_write_addr(ssd1306_dma_chan, &i2c_get_hw(i2c1)->data_cmd, false);
+
+    dma_channel_set_irq0_enabled(ssd1306_dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Indica se ainda há um envio por DMA em andamento (DMA, FIFO ou barramento ocupados)
+bool ssd1306_flush_busy()
+{
+    if (ssd1306_dma_chan < 0)
+    {
+        return false;
+    }
+
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+    {
+        // Display não respondeu: o controlador descarta o FIFO, então o envio é abandonado
+        dma_channel_abort(ssd1306_dma_chan);
+        (void)hw->clr_tx_abrt;
+        // A cópia da tela já tem o quadro abandonado: sem isso nada mais difere e a tela fica velha
+        ssd1306_invalidate();
+        return false;
+    }
+    return dma_channel_is_busy(ssd1306_dma_chan) ||
+           !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+           (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Espera o envio por DMA em andamento terminar
+void ssd1306_flush_wait()
+{
+    while (ssd1306_flush_busy())
+    {
+        tight_loop_contents();
+    }
+}
+
+// Calcular quanto do buffer será destinado à área de renderização
+void calculate_render_area_buffer_length(struct render_area *area)
+{
+    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+}
+
+// Processo de escrita do i2c espera um byte de controle, seguido por dados
+void ssd1306_send_command(uint8_t command)
+{
+    ssd1306_flush_wait(); // Não mistura com um envio por DMA em andamento
+    uint8_t buffer[2] = {0x80, command};
+    ssd1306_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+}
+
+// Envia uma lista de comandos ao hardware numa única transação
+// O byte de controle 0x00 (Co = 0, D/C = 0) indica que todos os bytes seguintes são comandos
+void ssd1306_send_command_list(uint8_t *ssd, int number)
+{
+    ssd1306_flush_wait();
+
+    ssd1306_tx_buffer[0] = 0x00;
+    memcpy(ssd1306_tx_buffer + 1, ssd, number);
+
+    ssd1306_write_blocking(i2c1, ssd1306_i2c_address, ssd1306_tx_buffer, number + 1, false);
+}
+
+// Copia buffer de referência no buffer persistente, a fim de adicionar o byte de controle desde o início
+void ssd1306_send_buffer(uint8_t ssd[], int buffer_length)
+{
+    ssd1306_flush_wait();
+
+    ssd1306_tx_buffer[0] = 0x40;
+    memcpy(ssd1306_tx_buffer + 1, ssd, buffer_length);
+
+    ssd1306_write_blocking(i2c1, ssd1306_i2c_address, ssd1306_tx_buffer, buffer_length + 1, false);
+}
+
+// Acrescenta uma transação (byte de controle + bytes) às palavras do DMA, com STOP no último byte
+static void ssd1306_dma_push_transaction(uint8_t control, const uint8_t *bytes, uint length)
+{
+    ssd1306_dma_words[ssd1306_dma_count++] = control;
+    for (uint i = 0; i < length; i++)
+    {
+        ssd1306_dma_words[ssd1306_dma_count++] = bytes[i];
+    }
+    ssd1306_dma_words[ssd1306_dma_count - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    ssd1306_bus_byte_count += length + 2;
+}
+
+// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
+void ssd1306_init()
+{
+    uint8_t commands[] = {
+        ssd1306_set_display,
+        ssd1306_set_memory_mode,
+        0x00,
+        ssd1306_set_display_start_line,
+        ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio,
+        ssd1306_height - 1,
+        ssd1306_set_common_output_direction | 0x08,
+        ssd1306_set_display_offset,
+        0x00,
+        ssd1306_set_common_pin_configuration,
+
+#if ((ssd1306_width == 128) && (ssd1306_height == 32))
+        0x02,
+#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
+        0x12,
+#else
+        0x02,
+#endif
+        ssd1306_set_display_clock_divide_ratio,
+        0x80,
+        ssd1306_set_precharge,
+        0xF1,
+        ssd1306_set_vcomh_deselect_level,
+        0x30,
+        ssd1306_set_contrast,
+        0xFF,
+        ssd1306_set_entire_on,
+        ssd1306_set_normal_display,
+        ssd1306_set_charge_pump,
+        0x14,
+        ssd1306_set_scroll | 0x00,
+        ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_send_command_list(commands, count_of(commands));
+}
+
+// Cria a lista de comandos para configurar o scrolling
+void ssd1306_scroll(bool set)
+{
+    uint8_t commands[] = {
+        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
+        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)};
+
+    ssd1306_send_command_list(commands, count_of(commands));
+}
+
+// Atualiza uma parte do display com uma área de renderização
+void render_on_display(uint8_t *ssd, struct render_area *area)
+{
+    uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page};
+
+    ssd1306_send_command_list(commands, count_of(commands));
+    ssd1306_send_buffer(ssd, area->buffer_length);
+}
+
+// Cópia do conteúdo atual da tela, usada para descobrir o que mudou no framebuffer
+static uint8_t ssd1306_shadow[ssd1306_buffer_length];
+static bool ssd1306_shadow_valid = false;
+
+// Força o próximo render_changes_on_display() a enviar a tela inteira
+void ssd1306_invalidate()
+{
+    ssd1306_shadow_valid = false;
+}
+
+// Envia ao display, por DMA e sem bloquear, só as colunas que mudaram em cada página do framebuffer
+// Cada página suja vira uma área de renderização com o menor intervalo de colunas que a cobre
+// Os bytes são copiados na hora, então o framebuffer pode ser alterado logo em seguida
+// Retorna false (sem enviar nada) se o envio anterior ainda não terminou; done é chamado no fim do DMA
+bool render_changes_on_display_async(uint8_t *ssd, void (*done)(void))
+{
+    if (ssd1306_flush_busy())
+    {
+        return false;
+    }
+    ssd1306_dma_init();
+    ssd1306_dma_count = 0;
+
+    for (uint8_t page = 0; page < ssd1306_n_pages; page++)
+    {
+        uint8_t *row = ssd + page * ssd1306_width;
+        uint8_t *shadow_row = ssd1306_shadow + page * ssd1306_width;
+
+        if (ssd1306_shadow_valid && memcmp(row, shadow_row, ssd1306_width) == 0)
+        {
+            continue; // Página sem mudanças
+        }
+
+        int first = 0;
+        int last = ssd1306_width - 1;
+        if (ssd1306_shadow_valid)
+        {
+            while (row[first] == shadow_row[first])
+                first++;
+            while (row[last] == shadow_row[last])
+                last--;
+        }
+
+        // Comandos de endereço num stream de comandos (controle 0x00) e os dados (controle 0x40)
+        uint8_t commands[] = {
+            ssd1306_set_column_address, first, last,
+            ssd1306_set_page_address, page, page};
+        ssd1306_dma_push_transaction(0x00, commands, count_of(commands));
+        ssd1306_dma_push_transaction(0x40, row + first, last - first + 1);
+        memcpy(shadow_row + first, row + first, last - first + 1);
+    }
+    ssd1306_shadow_valid = true;
+
+    if (ssd1306_dma_count == 0)
+    {
+        if (done)
+        {
+            done();
+        }
+        return true;
+    }
+
+    // Endereço do display no controlador I2C (só pode ser trocado com o I2C desabilitado)
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+    hw->enable = 0;
+    hw->tar = ssd1306_i2c_address;
+    hw->enable = 1;
+
+    ssd1306_dma_done = done;
+    ssd1306_dma_start_us = stats_begin();
+    dma_channel_set_read_addr(ssd1306_dma_chan, ssd1306_dma_words, false);
+    dma_channel_set_trans_count(ssd1306_dma_chan, ssd1306_dma_count, true);
+    return true;
+}
+
+// Versão bloqueante: envia as mudanças e espera o fim da transmissão
+void render_changes_on_display(uint8_t *ssd)
+{
+    ssd1306_flush_wait();
+    render_changes_on_display_async(ssd, NULL);
+    ssd1306_flush_wait();
+}
+
+// Comando de configuração com base na estrutura ssd1306_t
+void ssd1306_command(ssd1306_t *ssd, uint8_t command)
+{
+    ssd1306_flush_wait();
+    ssd->port_buffer[1] = command;
+    ssd1306_write_blocking(
+        ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+}
+
+// Envia uma lista de comandos numa única transação, com base na estrutura ssd1306_t
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, int number)
+{
+    ssd1306_flush_wait();
+
+    ssd1306_tx_buffer[0] = 0x00;
+    memcpy(ssd1306_tx_buffer + 1, commands, number);
+
+    ssd1306_write_blocking(
+        ssd->i2c_port, ssd->address, ssd1306_tx_buffer, number + 1, false);
+}
+
+// Função de configuração do display para o caso do bitmap (toda a sequência numa única transação)
+void ssd1306_config(ssd1306_t *ssd)
+{
+    uint8_t commands[] = {
+        ssd1306_set_display | 0x00,
+        ssd1306_set_memory_mode,
+        0x01,
+        ssd1306_set_display_start_line | 0x00,
+        ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio,
+        ssd1306_height - 1,
+        ssd1306_set_common_output_direction | 0x08,
+        ssd1306_set_display_offset,
+        0x00,
+        ssd1306_set_common_pin_configuration,
+        0x12,
+        ssd1306_set_display_clock_divide_ratio,
+        0x80,
+        ssd1306_set_precharge,
+        0xF1,
+        ssd1306_set_vcomh_deselect_level,
+        0x30,
+        ssd1306_set_contrast,
+        0xFF,
+        ssd1306_set_entire_on,
+        ssd1306_set_normal_display,
+        ssd1306_set_charge_pump,
+        0x14,
+        ssd1306_set_display | 0x01,
+    };
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+}
+
+// Inicializa o display para o caso de exibição de bitmap
+void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c)
+{
+    ssd->width = width;
+    ssd->height = height;
+    ssd->pages = height / 8U;
+    ssd->address = address;
+    ssd->i2c_port = i2c;
+    ssd->bufsize = ssd->pages * ssd->width + 1;
+    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+    ssd->ram_buffer[0] = 0x40;
+    ssd->port_buffer[0] = 0x80;
+}
+
+// Envia os dados ao display
+void ssd1306_send_data(ssd1306_t *ssd)
+{
+    uint8_t commands[] = {
+        ssd1306_set_column_address, 0, ssd->width - 1,
+        ssd1306_set_page_address, 0, ssd->pages - 1};
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+    ssd1306_write_blocking(
+        ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+}
+
+// Envia ao display apenas a janela de colunas [x_0, x_1] e páginas [page_0, page_1] do ram_buffer
+// O modo de endereçamento é vertical (ssd1306_config), então os bytes seguem coluna a coluna
+void ssd1306_send_area(ssd1306_t *ssd, int x_0, int x_1, int page_0, int page_1)
+{
+    if (x_0 < 0)
+        x_0 = 0;
+    if (x_1 > ssd->width - 1)
+        x_1 = ssd->width - 1;
+    if (page_0 < 0)
+        page_0 = 0;
+    if (page_1 > ssd->pages - 1)
+        page_1 = ssd->pages - 1;
+    if (x_0 > x_1 || page_0 > page_1)
+    {
+        return;
+    }
+
+    uint8_t commands[] = {
+        ssd1306_set_column_address, x_0, x_1,
+        ssd1306_set_page_address, page_0, page_1};
+
+    ssd1306_command_list(ssd, commands, count_of(commands));
+
+    // Janela inteira: o ram_buffer já está na ordem certa, com o byte de controle na frente
+    if (x_0 == 0 && x_1 == ssd->width - 1 && page_0 == 0 && page_1 == ssd->pages - 1)
+    {
+        ssd1306_write_blocking(
+            ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+        return;
+    }
+
+    int length = 1;
+    ssd1306_tx_buffer[0] = 0x40;
+    for (int x = x_0; x <= x_1; x++)
+    {
+        const uint8_t *column = ssd->ram_buffer + 1 + x * ssd->pages;
+        for (int page = page_0; page <= page_1; page++)
+        {
+            ssd1306_tx_buffer[length++] = column[page];
+        }
+    }
+
+    ssd1306_write_blocking(
+        ssd->i2c_port, ssd->address, ssd1306_tx_buffer, length, false);
+}
+
+// Copia um bitmap de width x height pixels para o ram_buffer na posição (x, y), recortando o que sair da tela
+// O bitmap segue o mesmo formato do ram_buffer: coluna a coluna, com (height + 7) / 8 bytes por coluna
+// y não precisa ser múltiplo de 8; as linhas fora do bitmap preservam o conteúdo já existente
+void ssd1306_blit(ssd1306_t *ssd, const uint8_t *bitmap, int x, int y, int width, int height)
+{
+    const int src_pages = (height + 7) / 8;
+    const int shift = y & 7;            // Deslocamento dentro da página de destino
+    const int page_0 = (y - shift) / 8; // Página de destino do primeiro byte (pode ser negativa)
+
+    for (int cx = 0; cx < width; cx++)
+    {
+        int dx = x + cx;
+        if (dx < 0 || dx >= ssd->width)
+        {
+            continue;
+        }
+
+        const uint8_t *src = bitmap + cx * src_pages;
+        uint8_t *column = ssd->ram_buffer + 1 + dx * ssd->pages;
+
+        for (int sp = 0; sp < src_pages; sp++)
+        {
+            int rows = height - sp * 8;
+            uint16_t mask = rows >= 8 ? 0xFF : (1u << rows) - 1;
+            uint16_t bits = (src[sp] & mask) << shift;
+            mask <<= shift;
+
+            int page = page_0 + sp;
+            if (page >= 0 && page < ssd->pages)
+            {
+                column[page] = (column[page] & ~mask) | (bits & 0xFF);
+            }
+            page++;
+            if (shift && page >= 0 && page < ssd->pages)
+            {
+                column[page] = (column[page] & ~(mask >> 8)) | (bits >> 8);
+            }
+        }
+    }
+}
+
+// Desenha um bitmap na posição (x, y) e envia somente as páginas e colunas que ele cobre
+void ssd1306_draw_bitmap_at(ssd1306_t *ssd, const uint8_t *bitmap, int x, int y, int width, int height)
+{
+    ssd1306_blit(ssd, bitmap, x, y, width, height);
+
+    if (y + height <= 0)
+    {
+        return;
+    }
+    int page_0 = y < 0 ? 0 : y / 8;
+    int page_1 = (y + height - 1) / 8;
+    ssd1306_send_area(ssd, x, x + width - 1, page_0, page_1);
+}
+
+// Desenha o bitmap (a ser fornecido em display_oled.c) no display
+// Copia a tela inteira para o ram_buffer e envia uma única vez
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap)
+{
+    memcpy(ssd->ram_buffer + 1, bitmap, ssd->bufsize - 1);
+    ssd1306_send_data(ssd);
+}
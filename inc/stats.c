@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <string.h>
+#include "stats.h"
+
+// Instrumentação sempre ligada: contadores de tamanho fixo, atualizados em poucas instruções
+// Cada etapa, período e contador tem um único escritor, então não há trava; a leitura do dump pode
+// pegar um valor no meio de uma atualização, o que é aceitável para diagnóstico
+// O stats_reset roda no núcleo 0 e só zera o que é escrito no núcleo 0 (com as IRQs desligadas);
+// a etapa do núcleo 1 (STATS_LIVE_PROCESS) é zerada pelo próprio núcleo 1, no próximo registro dele,
+// quando vê que o número de pedidos mudou
+
+typedef struct
+{
+    uint32_t last_us;     // Instante do evento anterior (0 = recomeçar)
+    uint32_t expected_us; // Intervalo esperado mais recente
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t late;        // Intervalos acima de 1,5x o esperado (bloco perdido ou quase)
+    stats_histogram_t jitter; // |intervalo - esperado|
+} stats_period_state_t;
+
+static stats_histogram_t stats_stages[STATS_STAGES];
+static stats_period_state_t stats_periods[STATS_PERIODS];
+static volatile uint32_t stats_counters[STATS_COUNTERS];
+static volatile uint32_t stats_live_reset_requests = 0; // Escrito só pelo núcleo 0
+static volatile uint32_t stats_live_reset_done = 0;     // Escrito só pelo núcleo 1
+
+static const char *const stats_stage_names[STATS_STAGES] = {"captura", "reproducao", "ao_vivo", "display_i2c"};
+static const char *const stats_period_names[STATS_PERIODS] = {"captura", "reproducao"};
+static const char *const stats_counter_names[STATS_COUNTERS] = {"adc_overrun", "adc_underrun", "reproducao_underrun"};
+
+static inline uint32_t stats_bucket(uint32_t us)
+{
+    uint32_t bucket = us ? 32 - __builtin_clz(us) : 0;
+    return bucket < STATS_BUCKETS ? bucket : STATS_BUCKETS - 1;
+}
+
+static inline void stats_histogram_add(stats_histogram_t *h, uint32_t us)
+{
+    h->count++;
+    h->sum_us += us;
+    if (us > h->max_us)
+    {
+        h->max_us = us;
+    }
+    h->buckets[stats_bucket(us)]++;
+}
+
+void stats_reset(void)
+{
+    uint32_t irq = hal_irq_disable();
+    for (int i = 0; i < STATS_STAGES; i++)
+    {
+        if (i != STATS_LIVE_PROCESS)
+        {
+            memset(&stats_stages[i], 0, sizeof(stats_stages[i]));
+        }
+    }
+    stats_live_reset_requests++;
+    memset(stats_periods, 0, sizeof(stats_periods));
+    for (int i = 0; i < STATS_COUNTERS; i++)
+    {
+        stats_counters[i] = 0;
+    }
+    hal_irq_restore(irq);
+}
+
+void stats_record(stats_stage_t stage, uint32_t elapsed_us)
+{
+    if (stage == STATS_LIVE_PROCESS)
+    {
+        uint32_t requests = stats_live_reset_requests;
+        if (requests != stats_live_reset_done)
+        {
+            memset(&stats_stages[stage], 0, sizeof(stats_stages[stage]));
+            stats_live_reset_done = requests;
+        }
+    }
+    stats_histogram_add(&stats_stages[stage], elapsed_us);
+}
+
+// Registra uma ocorrência de um evento periódico; o primeiro depois de stats_period_restart só marca o instante
+void stats_period(stats_period_t period, uint32_t expected_us)
+{
+    stats_period_state_t *p = &stats_periods[period];
+    uint32_t now = hal_time_us() | 1; // Nunca 0, que marca "recomeçar"
+
+    if (p->last_us)
+    {
+        uint32_t interval = now - p->last_us;
+        if (p->jitter.count == 0 || interval < p->min_us)
+        {
+            p->min_us = interval;
+        }
+        if (interval > p->max_us)
+        {
+            p->max_us = interval;
+        }
+        if (interval > expected_us + expected_us / 2)
+        {
+            p->late++;
+        }
+        stats_histogram_add(&p->jitter, interval > expected_us ? interval - expected_us : expected_us - interval);
+    }
+    p->expected_us = expected_us;
+    p->last_us = now;
+}
+
+// O próximo evento não mede intervalo (ex.: reprodução recomeçando depois de parada)
+void stats_period_restart(stats_period_t period)
+{
+    stats_periods[period].last_us = 0;
+}
+
+void stats_count(stats_counter_t counter)
+{
+    stats_counters[counter]++;
+}
+
+static void stats_print_buckets(const stats_histogram_t *h)
+{
+    printf("[");
+    for (int i = 0; i < STATS_BUCKETS; i++)
+    {
+        printf(i ? ",%lu" : "%lu", (unsigned long)h->buckets[i]);
+    }
+    printf("]");
+}
+
+// Envia tudo pela saída padrão (USB CDC no firmware) como linhas JSON
+void stats_dump(void)
+{
+    static const stats_histogram_t empty;
+    for (int i = 0; i < STATS_STAGES; i++)
+    {
+        // Zeragem pedida ao núcleo 1 e ainda não feita: a etapa já conta como vazia
+        bool pending = i == STATS_LIVE_PROCESS && stats_live_reset_requests != stats_live_reset_done;
+        const stats_histogram_t *h = pending ? &empty : &stats_stages[i];
+        printf("{\"etapa\":\"%s\",\"n\":%lu,\"us_med\":%lu,\"us_max\":%lu,\"hist\":", stats_stage_names[i],
+               (unsigned long)h->count, (unsigned long)(h->count ? h->sum_us / h->count : 0), (unsigned long)h->max_us);
+        stats_print_buckets(h);
+        printf("}\n");
+    }
+    for (int i = 0; i < STATS_PERIODS; i++)
+    {
+        const stats_period_state_t *p = &stats_periods[i];
+        printf("{\"periodo\":\"%s\",\"n\":%lu,\"esperado_us\":%lu,\"us_min\":%lu,\"us_max\":%lu,\"atrasos\":%lu,"
+               "\"jitter_us_med\":%lu,\"jitter_us_max\":%lu,\"jitter_hist\":",
+               stats_period_names[i], (unsigned long)p->jitter.count, (unsigned long)p->expected_us,
+               (unsigned long)p->min_us, (unsigned long)p->max_us, (unsigned long)p->late,
+               (unsigned long)(p->jitter.count ? p->jitter.sum_us / p->jitter.count : 0), (unsigned long)p->jitter.max_us);
+        stats_print_buckets(&p->jitter);
+        printf("}\n");
+    }
+    printf("{\"contadores\":{");
+    for (int i = 0; i < STATS_COUNTERS; i++)
+    {
+        printf(i ? ",\"%s\":%lu" : "\"%s\":%lu", stats_counter_names[i], (unsigned long)stats_counters[i]);
+    }
+    printf("}}\n");
+}
@@ -0,0 +1,61 @@
+#include "hal.h"
+
+#ifndef stats_inc_h
+#define stats_inc_h
+
+#define STATS_BUCKETS 16 // Histogramas em potências de 2 de µs: [0], [1], [2,3], [4,7] ... [16384, ∞)
+
+// Etapas com tempo de execução medido (cada uma escrita por um único contexto)
+typedef enum
+{
+    STATS_CAPTURE,       // Bloco da captura: dizimação, entrada e consumidor (IRQ do DMA, núcleo 0)
+    STATS_PLAYBACK_FILL, // Preenchimento de uma metade da reprodução (IRQ do DMA, núcleo 0)
+    STATS_LIVE_PROCESS,  // Bloco do modo ao vivo (núcleo 1)
+    STATS_DISPLAY_BUS,   // Barramento I2C ocupado pelo display, por envio
+    STATS_STAGES
+} stats_stage_t;
+
+// Eventos periódicos cujo intervalo real é comparado com o esperado (jitter)
+typedef enum
+{
+    STATS_PERIOD_CAPTURE,  // Blocos do rodízio do ADC
+    STATS_PERIOD_PLAYBACK, // Trocas de metade da reprodução
+    STATS_PERIODS
+} stats_period_t;
+
+// Falhas contadas
+typedef enum
+{
+    STATS_ADC_OVERRUN,       // FIFO do ADC transbordou (o DMA não acompanhou)
+    STATS_ADC_UNDERRUN,      // FIFO do ADC lido vazio
+    STATS_PLAYBACK_UNDERRUN, // Uma metade acabou de tocar antes da outra ser preenchida
+    STATS_COUNTERS
+} stats_counter_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[STATS_BUCKETS];
+} stats_histogram_t;
+
+extern void stats_reset(void);
+extern void stats_record(stats_stage_t stage, uint32_t elapsed_us);
+extern void stats_period(stats_period_t period, uint32_t expected_us);
+extern void stats_period_restart(stats_period_t period);
+extern void stats_count(stats_counter_t counter);
+extern void stats_dump(void);
+
+// Marca o início de uma etapa; stats_end registra o tempo decorrido (uma leitura do TIMERAWL cada)
+static inline uint32_t stats_begin(void)
+{
+    return hal_time_us();
+}
+
+static inline void stats_end(stats_stage_t stage, uint32_t start_us)
+{
+    stats_record(stage, hal_time_us() - start_us);
+}
+
+#endif
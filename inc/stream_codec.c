@@ -0,0 +1,117 @@
+#include <string.h>
+#include "stream_codec.h"
+
+// CRC-16/CCITT por nibble: tabela de 16 entradas, 32 bytes de flash em vez dos 512 da tabela cheia
+static const uint16_t stream_crc_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+uint16_t stream_crc16(uint16_t crc, const uint8_t *data, uint length)
+{
+    for (uint i = 0; i < length; i++)
+    {
+        crc = (crc << 4) ^ stream_crc_table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ stream_crc_table[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+    return crc;
+}
+
+static inline void stream_put16(uint8_t *out, uint16_t value)
+{
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+static inline uint16_t stream_get16(const uint8_t *in)
+{
+    return in[0] | (in[1] << 8);
+}
+
+// Monta o quadro em out (até STREAM_FRAME_MAX bytes) e retorna o tamanho
+uint stream_encode(const stream_frame_t *frame, uint8_t *out)
+{
+    uint8_t *p = out;
+
+    *p++ = STREAM_SYNC_0;
+    *p++ = STREAM_SYNC_1;
+    *p++ = (STREAM_VERSION << 4) | frame->source;
+    *p++ = frame->count;
+    stream_put16(p, frame->sequence);
+    stream_put16(p + 2, frame->rate);
+    p += 4;
+    for (uint i = 0; i < frame->count; i++, p += 2)
+    {
+        stream_put16(p, (uint16_t)frame->samples[i]);
+    }
+    stream_put16(p, stream_crc16(0xFFFF, out + 2, p - (out + 2)));
+    return p + STREAM_CRC_SIZE - out;
+}
+
+void stream_decoder_reset(stream_decoder_t *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+}
+
+// Descarta os n primeiros bytes guardados
+static void stream_decoder_drop(stream_decoder_t *decoder, uint n)
+{
+    decoder->length -= n;
+    memmove(decoder->buffer, decoder->buffer + n, decoder->length);
+}
+
+// Acrescenta um byte; retorna true quando ele completa um quadro válido, copiado para frame
+// Num cabeçalho ou CRC inválido só o primeiro byte de sincronismo é descartado, e a busca recomeça
+// no byte seguinte: um quadro bom logo depois de um corrompido não se perde
+bool stream_decoder_push(stream_decoder_t *decoder, uint8_t byte, stream_frame_t *frame)
+{
+    uint8_t *buffer = decoder->buffer;
+
+    buffer[decoder->length++] = byte;
+    while (decoder->length > 0)
+    {
+        if (buffer[0] != STREAM_SYNC_0 || (decoder->length > 1 && buffer[1] != STREAM_SYNC_1))
+        {
+            decoder->skipped_bytes++;
+            stream_decoder_drop(decoder, 1);
+            continue;
+        }
+        if (decoder->length < STREAM_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        uint count = buffer[3];
+        if ((buffer[2] >> 4) != STREAM_VERSION || (buffer[2] & 0x0F) >= STREAM_SOURCES ||
+            count == 0 || count > STREAM_MAX_SAMPLES)
+        {
+            decoder->skipped_bytes++;
+            stream_decoder_drop(decoder, 1);
+            continue;
+        }
+
+        uint size = STREAM_HEADER_SIZE + 2 * count + STREAM_CRC_SIZE;
+        if (decoder->length < size)
+        {
+            return false;
+        }
+        if (stream_crc16(0xFFFF, buffer + 2, size - 2 - STREAM_CRC_SIZE) != stream_get16(buffer + size - STREAM_CRC_SIZE))
+        {
+            decoder->crc_errors++;
+            decoder->skipped_bytes++;
+            stream_decoder_drop(decoder, 1);
+            continue;
+        }
+
+        frame->source = buffer[2] & 0x0F;
+        frame->count = count;
+        frame->sequence = stream_get16(buffer + 4);
+        frame->rate = stream_get16(buffer + 6);
+        for (uint i = 0; i < count; i++)
+        {
+            frame->samples[i] = (int16_t)stream_get16(buffer + STREAM_HEADER_SIZE + 2 * i);
+        }
+        stream_decoder_drop(decoder, size);
+        return true;
+    }
+    return false;
+}
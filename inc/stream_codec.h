@@ -0,0 +1,55 @@
+#include "hal.h"
+
+#ifndef stream_codec_inc_h
+#define stream_codec_inc_h
+
+// Protocolo binário do streaming de áudio pela USB (quadros pequenos, little-endian):
+//   [0]    0xA5           sincronismo
+//   [1]    0x5A           sincronismo
+//   [2]    versão << 4 | origem
+//   [3]    amostras no quadro (1 a STREAM_MAX_SAMPLES)
+//   [4..5] número de sequência (por origem, dá a volta em 65536)
+//   [6..7] taxa de amostragem em Hz
+//   [8..]  amostras Q15 (2 bytes cada)
+//   [fim]  CRC-16/CCITT (0x1021, início 0xFFFF) dos bytes 2 até o fim das amostras
+// O texto do printf divide o mesmo link; o decodificador pula tudo que não forma um quadro válido
+
+#define STREAM_SYNC_0 0xA5
+#define STREAM_SYNC_1 0x5A
+#define STREAM_VERSION 1
+#define STREAM_HEADER_SIZE 8
+#define STREAM_CRC_SIZE 2
+#define STREAM_MAX_SAMPLES 64 // Um bloco da captura ou da reprodução
+#define STREAM_FRAME_MAX (STREAM_HEADER_SIZE + 2 * STREAM_MAX_SAMPLES + STREAM_CRC_SIZE)
+
+typedef enum
+{
+    STREAM_SOURCE_CAPTURE, // Microfone depois da etapa de entrada (o que é gravado)
+    STREAM_SOURCE_OUTPUT,  // Níveis entregues à reprodução (o que vai para o buzzer)
+    STREAM_SOURCES
+} stream_source_t;
+
+typedef struct
+{
+    uint8_t source;
+    uint8_t count;
+    uint16_t sequence;
+    uint16_t rate;
+    int16_t samples[STREAM_MAX_SAMPLES];
+} stream_frame_t;
+
+// Decodificador incremental: recebe um byte por vez e se ressincroniza sozinho depois de erros
+typedef struct
+{
+    uint8_t buffer[STREAM_FRAME_MAX];
+    uint length;
+    uint32_t skipped_bytes; // Bytes fora de quadros (texto, lixo, quadros corrompidos)
+    uint32_t crc_errors;
+} stream_decoder_t;
+
+extern uint16_t stream_crc16(uint16_t crc, const uint8_t *data, uint length);
+extern uint stream_encode(const stream_frame_t *frame, uint8_t *out);
+extern void stream_decoder_reset(stream_decoder_t *decoder);
+extern bool stream_decoder_push(stream_decoder_t *decoder, uint8_t byte, stream_frame_t *frame);
+
+#endif
@@ -0,0 +1,85 @@
+#include "vad.h"
+
+// Converte uma duração em blocos, arredondando para cima (pelo menos 1)
+static uint32_t vad_blocks(uint32_t ms, uint32_t sample_rate, uint32_t block_size)
+{
+    uint32_t samples = sample_rate * ms / 1000;
+    return samples < block_size ? 1 : (samples + block_size - 1) / block_size;
+}
+
+void vad_init(vad_t *vad, uint32_t sample_rate, uint32_t block_size)
+{
+    vad->dc = 0;
+    vad->noise = VAD_MIN_ENERGY / VAD_SPEECH_RATIO;
+    vad->onset_blocks = vad_blocks(VAD_ONSET_MS, sample_rate, block_size);
+    vad->hangover_blocks = vad_blocks(VAD_HANGOVER_MS, sample_rate, block_size);
+    vad->speech_run = 0;
+    vad->silence_run = 0;
+    vad->active = false;
+}
+
+// Analisa um bloco Q15 e devolve se há voz (já com a espera de disparo e de encerramento)
+bool vad_process(vad_t *vad, const int16_t *block, uint32_t count)
+{
+    uint32_t energy = 0;
+    uint32_t crossings = 0;
+    int32_t previous = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        // Passa-altas de um polo: o microfone tem um pequeno DC que atrapalharia os cruzamentos por zero
+        int32_t x = block[i] - (vad->dc >> 8);
+        vad->dc += x << (8 - VAD_DC_SHIFT);
+
+        int32_t scaled = x >> 3; // (x/8)^2 cabe em 24 bits e a soma de 64 amostras em 32
+        energy += (uint32_t)(scaled * scaled);
+        crossings += (i > 0) && ((x ^ previous) < 0);
+        previous = x;
+    }
+    energy /= count;
+
+    uint32_t threshold = vad->noise * VAD_SPEECH_RATIO;
+    if (threshold < VAD_MIN_ENERGY)
+    {
+        threshold = VAD_MIN_ENERGY;
+    }
+    // Muitos cruzamentos só contam como fala se a energia for bem alta (consoantes fortes)
+    bool speech = energy > threshold && (2 * crossings < count || energy > VAD_SPEECH_RATIO * threshold);
+
+    // O ruído de fundo segue os blocos sem fala; desce rápido e sobe devagar
+    if (!speech)
+    {
+        if (energy < vad->noise)
+        {
+            vad->noise -= (vad->noise - energy) >> 2;
+        }
+        else
+        {
+            vad->noise += (energy - vad->noise) >> 5;
+        }
+    }
+    else if (!vad->active)
+    {
+        vad->noise += (energy - vad->noise) >> 8; // Ruído alto e constante acaba virando fundo
+    }
+
+    if (!vad->active)
+    {
+        vad->speech_run = speech ? vad->speech_run + 1 : 0;
+        if (vad->speech_run >= vad->onset_blocks)
+        {
+            vad->active = true;
+            vad->silence_run = 0;
+        }
+    }
+    else
+    {
+        vad->silence_run = speech ? 0 : vad->silence_run + 1;
+        if (vad->silence_run >= vad->hangover_blocks)
+        {
+            vad->active = false;
+            vad->speech_run = 0;
+        }
+    }
+    return vad->active;
+}
@@ -0,0 +1,29 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef vad_inc_h
+#define vad_inc_h
+
+#define VAD_ONSET_MS 30       // Fala contínua necessária para disparar
+#define VAD_HANGOVER_MS 800   // Silêncio contínuo necessário para encerrar
+#define VAD_MIN_ENERGY 400    // Energia mínima de fala (~ -46 dBFS), mesmo com o ambiente silencioso
+#define VAD_SPEECH_RATIO 8    // Fala: energia pelo menos 8x (9 dB) acima do ruído de fundo
+#define VAD_DC_SHIFT 6        // Constante do filtro que remove o nível DC (64 amostras)
+
+// Detector de atividade de voz por bloco: energia acima do ruído de fundo estimado e taxa de
+// cruzamentos por zero típica de voz (ruído de banda larga cruza zero em mais da metade das amostras)
+typedef struct
+{
+    int32_t dc;               // Nível DC em Q8
+    uint32_t noise;           // Energia do ruído de fundo
+    uint32_t onset_blocks;    // Blocos de fala para disparar
+    uint32_t hangover_blocks; // Blocos de silêncio para encerrar
+    uint32_t speech_run;      // Blocos seguidos com cara de fala (antes de disparar)
+    uint32_t silence_run;     // Blocos seguidos sem fala (depois de disparar)
+    bool active;
+} vad_t;
+
+extern void vad_init(vad_t *vad, uint32_t sample_rate, uint32_t block_size);
+extern bool vad_process(vad_t *vad, const int16_t *block, uint32_t count);
+
+#endif
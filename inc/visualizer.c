@@ -0,0 +1,152 @@
+#include <string.h>
+#include "visualizer.h"
+#include "fft.h"
+
+// Janela das últimas FFT_SIZE amostras para o espectro (buffer circular)
+static int16_t visualizer_samples[FFT_SIZE];
+static volatile uint32_t visualizer_sample_index = 0;
+
+// Histórico da forma de onda: mínimo e máximo (8 bits) de cada grupo de amostras
+static int8_t visualizer_column_min[VISUALIZER_COLUMNS];
+static int8_t visualizer_column_max[VISUALIZER_COLUMNS];
+static volatile uint32_t visualizer_column_index = 0;
+static int16_t visualizer_acc_min, visualizer_acc_max;
+static uint visualizer_acc_count = 0;
+
+// Altura atual de cada barra do espectro, que cai devagar entre quadros
+static uint8_t visualizer_bar[FFT_BINS];
+
+// Limpa o histórico; chamada antes de cada gravação, reprodução ou modo ao vivo
+void visualizer_reset(void)
+{
+    memset(visualizer_samples, 0, sizeof(visualizer_samples));
+    memset(visualizer_column_min, 0, sizeof(visualizer_column_min));
+    memset(visualizer_column_max, 0, sizeof(visualizer_column_max));
+    memset(visualizer_bar, 0, sizeof(visualizer_bar));
+    visualizer_sample_index = 0;
+    visualizer_column_index = 0;
+    visualizer_acc_count = 0;
+}
+
+// Recebe amostras Q15 do fluxo de áudio (IRQ do DMA ou núcleo 1); só um produtor por vez
+void visualizer_feed(const int16_t *samples, uint count)
+{
+    uint32_t index = visualizer_sample_index;
+
+    for (uint i = 0; i < count; i++)
+    {
+        int16_t sample = samples[i];
+        visualizer_samples[index++ & (FFT_SIZE - 1)] = sample;
+
+        if (visualizer_acc_count == 0 || sample < visualizer_acc_min)
+        {
+            visualizer_acc_min = sample;
+        }
+        if (visualizer_acc_count == 0 || sample > visualizer_acc_max)
+        {
+            visualizer_acc_max = sample;
+        }
+        if (++visualizer_acc_count == VISUALIZER_SAMPLES_PER_COLUMN)
+        {
+            uint32_t column = visualizer_column_index % VISUALIZER_COLUMNS;
+            visualizer_column_min[column] = visualizer_acc_min >> 8;
+            visualizer_column_max[column] = visualizer_acc_max >> 8;
+            visualizer_column_index++;
+            visualizer_acc_count = 0;
+        }
+    }
+    visualizer_sample_index = index;
+}
+
+// log2 em Q3 (oito passos por oitava, ~0,75 dB cada), por contagem de zeros à esquerda
+static int visualizer_log2_q3(uint32_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+    int n = 31 - __builtin_clz(value);
+    int frac = n >= 3 ? (value >> (n - 3)) & 7 : (value << (3 - n)) & 7;
+    return n * 8 + frac;
+}
+
+// Forma de onda rolando: coluna mais antiga à esquerda, cada uma uma linha vertical do mínimo ao máximo
+static void visualizer_render_waveform(uint8_t *ssd, int y, int height)
+{
+    uint32_t newest = visualizer_column_index;
+    int center = y + height / 2;
+    int half = height / 2;
+
+    for (int x = 0; x < VISUALIZER_COLUMNS; x++)
+    {
+        uint32_t column = (newest + x) % VISUALIZER_COLUMNS;
+        int top = center - ((visualizer_column_max[column] * half) >> 7);
+        int bottom = center - ((visualizer_column_min[column] * half) >> 7);
+        ssd1306_draw_vline(ssd, x, top, bottom, ssd1306_draw_set);
+    }
+}
+
+// Espectro: FFT das últimas 128 amostras, 64 barras de 2 pixels em escala logarítmica
+// Custo fixo por quadro (uma FFT e 64 retângulos), independente da taxa de amostragem
+static void visualizer_render_spectrum(uint8_t *ssd, int y, int height)
+{
+    int16_t re[FFT_SIZE];
+    int16_t im[FFT_SIZE];
+
+    // Cópia da janela sem travar o produtor; um bloco a mais no meio só borra um quadro
+    uint32_t start = visualizer_sample_index;
+    int32_t mean = 0;
+    for (int i = 0; i < FFT_SIZE; i++)
+    {
+        re[i] = visualizer_samples[(start + i) & (FFT_SIZE - 1)];
+        mean += re[i];
+    }
+    mean /= FFT_SIZE;
+    for (int i = 0; i < FFT_SIZE; i++)
+    {
+        re[i] -= mean; // Remove o nível DC do microfone
+        im[i] = 0;
+    }
+
+    fft_window_q15(re);
+    fft_q15(re, im);
+
+    // Piso no ruído de quantização de 8 bits (módulo ~8) e topo numa senoide em escala cheia (~8192)
+    const int floor_q3 = 3 * 8;
+    const int range_q3 = 13 * 8 - floor_q3;
+    const int bar_width = VISUALIZER_COLUMNS / FFT_BINS;
+
+    for (int bin = 0; bin < FFT_BINS; bin++)
+    {
+        int level = visualizer_log2_q3(fft_magnitude(re[bin], im[bin])) - floor_q3;
+        int bar = level <= 0 ? 0 : level * height / range_q3;
+        if (bar > height)
+        {
+            bar = height;
+        }
+
+        // Sobe na hora e desce dois pixels por quadro
+        if (bar < visualizer_bar[bin])
+        {
+            bar = visualizer_bar[bin] > 2 ? visualizer_bar[bin] - 2 : 0;
+        }
+        visualizer_bar[bin] = bar;
+
+        ssd1306_fill_rect(ssd, bin * bar_width, y + height - bar, bar_width, bar, ssd1306_draw_set);
+    }
+}
+
+// Desenha um quadro na faixa [y, y + height) do framebuffer, apagando a faixa antes
+void visualizer_render(uint8_t *ssd, int y, int height, visualizer_mode_t mode)
+{
+    ssd1306_fill_rect(ssd, 0, y, ssd1306_width, height, ssd1306_draw_clear);
+
+    if (mode == VISUALIZER_WAVEFORM)
+    {
+        visualizer_render_waveform(ssd, y, height);
+    }
+    else
+    {
+        visualizer_render_spectrum(ssd, y, height);
+    }
+}
@@ -0,0 +1,21 @@
+#include "hal.h"
+#include "ssd1306.h"
+
+#ifndef visualizer_inc_h
+#define visualizer_inc_h
+
+#define VISUALIZER_FRAME_MS 40              // Intervalo entre quadros (25 quadros por segundo)
+#define VISUALIZER_COLUMNS ssd1306_width    // Colunas do histórico da forma de onda
+#define VISUALIZER_SAMPLES_PER_COLUMN 64    // Amostras resumidas em cada coluna (~5,3 ms a 12 kHz)
+
+typedef enum
+{
+    VISUALIZER_SPECTRUM, // 64 barras de espectro (FFT de 128 pontos)
+    VISUALIZER_WAVEFORM  // Forma de onda rolando (mínimo e máximo de cada coluna)
+} visualizer_mode_t;
+
+extern void visualizer_reset(void);
+extern void visualizer_feed(const int16_t *samples, uint count);
+extern void visualizer_render(uint8_t *ssd, int y, int height, visualizer_mode_t mode);
+
+#endif
@@ -0,0 +1,57 @@
+#include "audio_playback.h"
+#include "audio_store.h"
+#include "pitch_shift.h"
+#include "resampler.h"
+#include "effects.h"
+#include "visualizer.h"
+#include "voice.h"
+
+static pitch_shift_t voice_pitch;
+static resampler_t voice_resampler; // Taxa da gravação x velocidade -> taxa da reprodução
+static uint voice_volume = 0;       // Deslocamento do nível, em passos de 256
+
+// Converte uma amostra Q15 no nível da reprodução (16 bits), aplicando o deslocamento de volume
+static inline uint16_t voice_sample_to_level(int16_t sample)
+{
+    uint level = (uint)(sample + 32768) + (voice_volume << 8);
+    return level > PLAYBACK_LEVEL_MAX ? PLAYBACK_LEVEL_MAX : level;
+}
+
+// Prepara a cadeia para um novo áudio na taxa sample_rate
+void voice_reset(int semitones, uint effect, uint volume, uint32_t sample_rate)
+{
+    pitch_shift_init(&voice_pitch);
+    pitch_shift_set_semitones(&voice_pitch, semitones);
+    effects_select(effect, sample_rate);
+    voice_volume = volume;
+}
+
+// Razão do reamostrador usado por voice_read_store; a velocidade entra multiplicando as taxas
+void voice_set_source(uint32_t source_rate, uint32_t output_rate)
+{
+    resampler_init(&voice_resampler, source_rate, output_rate);
+}
+
+// Processa um bloco (até PLAYBACK_BLOCK_SIZE amostras)
+void voice_process_block(const int16_t *in, uint16_t *out, uint count)
+{
+    int16_t block[PLAYBACK_BLOCK_SIZE];
+
+    pitch_shift_process(&voice_pitch, in, block, count);
+    effects_process(block, count);
+    visualizer_feed(block, count);
+    for (uint i = 0; i < count; i++)
+    {
+        out[i] = voice_sample_to_level(block[i]);
+    }
+}
+
+// Produz os níveis de um bloco a partir do audio_store (decodificando na hora)
+// Tem a forma de playback_fill_handler_t; retorna menos que count quando o áudio acaba
+uint voice_read_store(uint16_t *levels, uint count)
+{
+    int16_t samples[PLAYBACK_BLOCK_SIZE];
+    uint n = resampler_read(&voice_resampler, audio_store_read, samples, count);
+    voice_process_block(samples, levels, n);
+    return n;
+}
@@ -0,0 +1,14 @@
+#include "hal.h"
+
+#ifndef voice_inc_h
+#define voice_inc_h
+
+// Cadeia de mudança de voz, compartilhada entre reprodução e modo ao vivo (nunca rodam juntos):
+// amostra Q15 -> tom -> efeitos -> visualização -> nível da reprodução (0 a PLAYBACK_LEVEL_MAX)
+// Não depende do hardware: o firmware e o simulador do host usam o mesmo código
+extern void voice_reset(int semitones, uint effect, uint volume, uint32_t sample_rate);
+extern void voice_set_source(uint32_t source_rate, uint32_t output_rate);
+extern void voice_process_block(const int16_t *in, uint16_t *out, uint count);
+extern uint voice_read_store(uint16_t *levels, uint count);
+
+#endif
@@ -1,12 +1,27 @@
 #include <stdio.h>
 #include <string.h>
 #include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
 #include "hardware/adc.h"
 #include "hardware/dma.h"
-#include "hardware/pwm.h"
 #include "hardware/i2c.h"
 #include "hardware/clocks.h"
 #include "inc/ssd1306.h"
+#include "inc/audio_capture.h"
+#include "inc/audio_playback.h"
+#include "inc/audio_live.h"
+#include "inc/pitch_shift.h"
+#include "inc/effects.h"
+#include "inc/voice.h"
+#include "inc/vad.h"
+#include "inc/audio_store.h"
+#include "inc/flash_store_pico.h"
+#include "inc/visualizer.h"
+#include "inc/event_queue.h"
+#include "inc/adc_scheduler.h"
+#include "inc/joystick.h"
+#include "inc/stats.h"
+#include "inc/audio_stream.h"
 
 // Definições de pinos e configurações
 #define BUTTON_A 5                       // GPIO5 corresponde ao Botão A da BitDogLab
@@ -18,15 +33,20 @@
 #define I2C_SDA 14                       // GPIO14 corresponde ao SDA do Display OLED da BitDogLab
 #define I2C_SCL 15                       // GPIO15 corresponde ao SCL do Display OLED da BitDogLab
 #define I2C_PORT i2c1                    // Corresponde ao I2C dos GPIO14 e GPIO15
-#define SAMPLE_RATE 12000                // Taxa de amostragem de 12 kHz
-#define BUFFER_SIZE (SAMPLE_RATE * 5)    // Buffer para 5 segundos de áudio
-#define DELAY_SAMPLE (1e6 / SAMPLE_RATE) // Delay de cada amostra
+#define BUFFER_SIZE 120000               // Bytes de gravação: 10 s em 8 bits ou 20 s em ADPCM a 12 kHz
+#define RECORD_FORMAT AUDIO_STORE_ADPCM  // Formato da gravação (AUDIO_STORE_PCM8 ou AUDIO_STORE_ADPCM)
+#define PREROLL_BLOCKS 64                // Blocos guardados antes do disparo por voz (~340 ms a 12 kHz)
+#define RECORD_TAIL_MS 200               // Silêncio mantido no fim de uma gravação disparada por voz
 #define DEBOUNCE_DELAY_MS 200            // Definição de debounce (em milissegundos) dos Botões
 #define JOYSTICK_Y 26                    // GPIO26 corresponde ao Joystick no Eixo Y da BitDogLab
 #define JOYSTICK_X 27                    // GPIO27 corresponde ao Joystick no Eixo X da BitDogLab
 #define JOYSTICK_Y_CHANNEL 0             // Corresponde ao canal do ADC do GPIO26 da BitDogLab
 #define JOYSTICK_X_CHANNEL 1             // Corresponde ao canal do ADC do GPIO27 da BitDogLab
 #define JOYSTICK_BUTTON 22               // GPIO22 corresponde ao Botão do Joystick da BitDogLab
+#define MENU_TICK_MS 10                  // Intervalo de leitura do Joystick no menu
+#define MENU_REPEAT_TICKS 20             // Com o Joystick segurado, repete a ação a cada 200 ms
+#define MENU_LINES 9                     // Linhas selecionáveis do menu
+#define MENU_VISIBLE_LINES 7             // Linhas que cabem no display abaixo do título
 
 // Variáveis para debounce dos Botões
 volatile absolute_time_t last_button_A_press = {0};
@@ -34,9 +54,32 @@ volatile absolute_time_t last_button_B_press = {0};
 volatile absolute_time_t last_button_JOYSTICK_press = {0};
 
 // Variáveis para usar nos offsets de mudança de voz
-uint frequency_offset = 2400;
+int semitone_offset = 0; // Deslocamento de tom em semitons (-12 a +12)
 uint volume_offset = 0;
-int delay_offset = 0;
+uint effect_index = 0; // Cadeia de efeitos escolhida no menu
+
+// Velocidade da reprodução como razão exata (num/den), aplicada pelo reamostrador
+const uint8_t speed_num[] = {1, 2, 3, 1, 5, 3, 2};
+const uint8_t speed_den[] = {2, 3, 4, 1, 4, 2, 1};
+uint speed_index = 3; // x1
+
+// Taxas de amostragem, escolhidas em tempo de execução
+// A captura pode usar uma taxa menor para caber mais tempo na memória; a reprodução converte
+// qualquer gravação para playback_rate
+const uint32_t capture_rates[] = {8000, 12000, 16000, 24000};
+uint capture_rate_index = 1;      // 12 kHz
+uint32_t playback_rate = 16000;   // Taxa de saída nos buzzers
+uint32_t recorded_rate = 12000;   // Taxa da última gravação feita na RAM
+
+// Slot da flash onde as gravações são guardadas e de onde são tocadas
+uint8_t current_slot = 0;
+bool flash_ready = false;       // Região de gravações na flash montada
+uint32_t flash_saved_bytes = 0; // Bytes da gravação atual já enviados para a flash
+
+// Visualização exibida durante gravação, reprodução e modo ao vivo
+visualizer_mode_t visualizer_mode = VISUALIZER_SPECTRUM;
+const char *visualizer_title = ""; // Título da faixa de cima
+int visualizer_joystick_x = 0;       // Última direção do Joystick vista nos quadros
 
 // Variavel utilizada para fazer a configuração das variaveis de offset
 bool config_menu = false;
@@ -45,113 +88,261 @@ bool config_menu = false;
 typedef enum
 {
     STATE_IDLE,
-    STATE_INIT,
     STATE_RECORDING,
     STATE_PLAYING,
-    STATE_MENU
+    STATE_MENU,
+    STATE_LIVE
 } system_state_t;
-volatile system_state_t system_state = STATE_INIT;
+system_state_t system_state = STATE_IDLE; // Só o laço principal troca de estado (enter_state)
+
+// Eventos publicados pelas IRQs e timers e consumidos pelo laço principal
+typedef enum
+{
+    EVENT_BUTTON_A,        // Botão A pressionado (já com debounce)
+    EVENT_BUTTON_B,        // Botão B pressionado (já com debounce)
+    EVENT_BUTTON_JOYSTICK, // Botão do Joystick pressionado (já com debounce)
+    EVENT_AUDIO_DONE,      // Gravação, reprodução ou modo ao vivo terminou ou não começou (data: estado de origem)
+    EVENT_FRAME,           // Quadro da visualização e cópia da gravação para a flash
+    EVENT_MENU_TICK,       // Leitura periódica do Joystick no menu
+    EVENT_FLASH_SERVICE,   // Apaga mais um setor à frente do log da flash
+    EVENT_VOICE_DETECTED,  // A gravação armada detectou voz e começou a guardar
+    EVENT_USB_COMMAND,     // Chegaram caracteres pela USB (comandos de diagnóstico)
+    EVENT_USB_STREAM       // Há quadros de áudio esperando o envio pela USB
+} event_type_t;
+
+// Timers periódicos, ligados só nos estados que precisam deles
+repeating_timer_t frame_timer;
+repeating_timer_t menu_timer;
+bool frame_timer_active = false;
+bool menu_timer_active = false;
+
+// Evita acumular ticks na fila se o laço principal demorar (ex.: apagando a flash)
+volatile bool frame_pending = false;
+volatile bool menu_tick_pending = false;
+volatile bool usb_command_pending = false;
+volatile bool usb_stream_pending = false;
 
-// Variavel utilizada como o tamanho do buffer para a gravação do audio
-uint16_t audio_buffer[BUFFER_SIZE];
+// Memória da gravação, gerenciada pelo audio_store (amostras de 8 bits ou ADPCM)
+uint8_t audio_buffer[BUFFER_SIZE];
 
-// Função para configurar ADC com DMA
-void config_dma_mic(int dma_chan)
+// Gravação disparada por voz: a captura fica armada guardando os últimos blocos num anel (pre-roll)
+// Quando o VAD detecta voz, o anel vai inteiro para o início da gravação e o resto segue normalmente;
+// depois de VAD_HANGOVER_MS de silêncio a gravação termina, mantendo só RECORD_TAIL_MS desse silêncio
+bool record_on_voice = false;
+volatile bool record_armed = false; // Aguardando voz (nada foi guardado ainda)
+vad_t record_vad;
+int16_t preroll_buffer[PREROLL_BLOCKS][CAPTURE_BLOCK_SIZE];
+uint preroll_head = 0;  // Próximo bloco a escrever no anel
+uint preroll_count = 0; // Blocos válidos no anel
+
+// Guarda um bloco no audio_store; retorna false (e avisa o laço principal) quando a memória enche
+bool record_store_block(const int16_t *block, uint count)
 {
-    // Configuração do canal DMA
-    dma_channel_config cfg = dma_channel_get_default_config(dma_chan);
-    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16); // Transferência de 16 bits
-    channel_config_set_read_increment(&cfg, false);           // Leitura fixa (FIFO do ADC)
-    channel_config_set_write_increment(&cfg, true);           // Escrita incremental (buffer de áudio)
-    channel_config_set_dreq(&cfg, DREQ_ADC);                  // Sincronização com ADC
-
-    dma_channel_configure(
-        dma_chan,
-        &cfg,
-        audio_buffer,  // Destino: buffer de áudio
-        &adc_hw->fifo, // Origem: FIFO do ADC
-        BUFFER_SIZE,   // Número de transferências
-        false          // Não inicia imediatamente
-    );
+    if (audio_store_write(block, count) < count)
+    {
+        event_post(EVENT_AUDIO_DONE, STATE_RECORDING); // Gravação completa, volta para a tela inicial
+        return false;
+    }
+    return true;
 }
 
-// Função de gravação de áudio utilizando DMA
+// Bloco da captura enquanto armada; no disparo começa a gravação com o anel, do bloco mais antigo ao atual
+bool record_armed_block(const int16_t *block, uint count, bool voice)
+{
+    memcpy(preroll_buffer[preroll_head], block, count * sizeof(int16_t));
+    preroll_head = (preroll_head + 1) % PREROLL_BLOCKS;
+    if (preroll_count < PREROLL_BLOCKS)
+    {
+        preroll_count++;
+    }
+    if (!voice)
+    {
+        return true;
+    }
+
+    recorded_rate = capture_rates[capture_rate_index];
+    audio_store_begin_write(RECORD_FORMAT);
+    uint index = (preroll_head + PREROLL_BLOCKS - preroll_count) % PREROLL_BLOCKS;
+    bool space = true;
+    for (uint i = 0; i < preroll_count && space; i++)
+    {
+        space = record_store_block(preroll_buffer[index], count);
+        index = (index + 1) % PREROLL_BLOCKS;
+    }
+    record_armed = false; // Só depois da gravação começar, para o laço principal não copiar a gravação anterior
+    event_post(EVENT_VOICE_DETECTED, 0);
+    return space;
+}
+
+// Consumidor dos blocos da captura contínua: guarda cada bloco no audio_store
+// Executado no contexto da IRQ do DMA, retorna false quando a memória enche ou a fala termina
+bool record_block_handler(const int16_t *block, uint count)
+{
+    visualizer_feed(block, count);
+
+    if (!record_on_voice)
+    {
+        return record_store_block(block, count);
+    }
+
+    bool voice = vad_process(&record_vad, block, count);
+    if (record_armed)
+    {
+        return record_armed_block(block, count, voice);
+    }
+    if (!voice)
+    {
+        // Fim da fala: descarta o silêncio já guardado além da cauda
+        uint32_t tail_blocks = recorded_rate * RECORD_TAIL_MS / 1000 / count;
+        uint32_t silence_blocks = record_vad.hangover_blocks - 1; // O bloco atual não foi guardado
+        if (silence_blocks > tail_blocks)
+        {
+            uint32_t excess = (silence_blocks - tail_blocks) * count;
+            uint32_t length = audio_store_length();
+            audio_store_truncate(length > excess ? length - excess : 0);
+        }
+        event_post(EVENT_AUDIO_DONE, STATE_RECORDING);
+        return false;
+    }
+    return record_store_block(block, count);
+}
+
+// Função de gravação de áudio utilizando DMA, não bloqueante
 void record_audio()
 {
-    adc_select_input(MIC_CHANNEL); // Selecionar o canal do ADC que vai pegar os dados
+    uint32_t rate = capture_rates[capture_rate_index];
+    adc_scheduler_set_sample_rate(rate);
 
-    int dma_chan = dma_claim_unused_channel(true); // Pega o DMA que não esta sendo usado pelo canal
-    if (dma_chan < 0)
+    // Disparada por voz, a gravação anterior só é descartada quando a fala começar
+    record_armed = record_on_voice;
+    if (record_on_voice)
     {
-        printf("Erro: Not found DMA available.\n");
-        return;
+        vad_init(&record_vad, rate, CAPTURE_BLOCK_SIZE);
+        preroll_head = 0;
+        preroll_count = 0;
+    }
+    else
+    {
+        recorded_rate = rate;
+        audio_store_begin_write(RECORD_FORMAT);
     }
-    config_dma_mic(dma_chan); // Chama a função para configurar o Microfone
 
-    // Inicia a transferência DMA e o ADC
-    dma_channel_start(dma_chan);
-    adc_run(true);
+    // A gravação vai para a RAM e é copiada para a flash pelo laço principal
+    flash_saved_bytes = 0;
+    if (flash_ready && !flash_store_begin(current_slot, RECORD_FORMAT, rate))
+    {
+        printf("Aviso: flash ainda sendo apagada, gravacao so na RAM.\n");
+    }
 
-    // Aguarda a conclusão da transferência DMA (bloqueante)
-    dma_channel_wait_for_finish_blocking(dma_chan);
+    if (!audio_capture_start(record_block_handler))
+    {
+        printf("Erro: captura de audio ja em andamento.\n");
+        event_post(EVENT_AUDIO_DONE, STATE_RECORDING);
+    }
+}
 
-    // Para o ADC e libera o canal DMA
-    adc_run(false);
-    dma_channel_unclaim(dma_chan);
+// Encerra a gravação antes do buffer encher
+void stop_recording()
+{
+    audio_capture_stop();
 }
 
-// Função para configurar a frequência do PWM no pino do buzzer
-void set_pwm_frequency(uint gpio, uint32_t freq)
+// Envia para a flash os bytes da gravação que já estão completos na RAM e fecha o slot no fim
+// Roda no laço principal: páginas nunca são gravadas dentro da IRQ da captura
+// Com o áudio parado, aproveita para apagar setores à frente do log
+// Retorna true se ainda há setores para apagar
+bool flash_save_service()
 {
-    uint slice_num = pwm_gpio_to_slice_num(gpio);
-    // Calcula o divisor necessário para alcançar a frequência desejada com wrap de 256
-    uint32_t divisor = clock_get_hz(clk_sys) / freq / 256;
-    if (divisor < 16)
-        divisor = 16; // Garante que o divisor não seja zero
-    pwm_set_clkdiv_int_frac(slice_num, divisor / 16, divisor & 15);
+    if (flash_store_is_writing())
+    {
+        bool finished = !audio_capture_is_running(); // Lido antes do tamanho, para não perder o final
+        if (record_armed)
+        {
+            // Ainda sem voz: o audio_store tem a gravação anterior; parada assim, o slot fica como estava
+            if (finished)
+            {
+                flash_store_abort();
+            }
+            return false;
+        }
+        uint32_t bytes = finished ? audio_store_size_bytes() : audio_store_stable_bytes();
+        if (bytes > flash_saved_bytes)
+        {
+            flash_store_write(audio_store_data() + flash_saved_bytes, bytes - flash_saved_bytes);
+            flash_saved_bytes = bytes;
+        }
+        if (finished)
+        {
+            flash_store_finish(audio_store_length(), bytes);
+        }
+    }
+    else if (flash_ready && !audio_capture_is_running() && !audio_playback_is_running())
+    {
+        return flash_store_service();
+    }
+    return false;
 }
 
-// Função de reprodução de áudio
+// Chamado quando o último bloco termina de tocar
+void play_done_handler(void)
+{
+    event_post(EVENT_AUDIO_DONE, STATE_PLAYING); // Retorna ao estado inicial após reprodução
+}
+
+// Função de reprodução de áudio utilizando PIO + DMA, não bloqueante
 void play_audio()
 {
-    // Configura o PWM para o buzzer
-    uint slice_num_A = pwm_gpio_to_slice_num(BUZZER_PIN_A);
-    uint slice_num_B = pwm_gpio_to_slice_num(BUZZER_PIN_B);
-    pwm_set_wrap(slice_num_A, 255); // Define o wrap (resolução do PWM)
-    pwm_set_wrap(slice_num_B, 255); // Define o wrap (resolução do PWM)
-    pwm_set_gpio_level(BUZZER_PIN_A, 0);
-    pwm_set_gpio_level(BUZZER_PIN_B, 0);
-    pwm_set_enabled(slice_num_A, true);
-    pwm_set_enabled(slice_num_B, true);
-
-    // Loop para reproduzir cada amostra do buffer
-    for (int i = 0; i < BUFFER_SIZE; i++)
-    {
-        uint16_t sample = audio_buffer[i];
-        // Mapeia o valor da amostra para uma faixa de frequência inicialmente de 2400Hz para cima
-        // A variação pode ser ajustada conforme a aplicação
-        uint32_t frequency = frequency_offset + ((sample * 100) / 4096);
-        set_pwm_frequency(BUZZER_PIN_A, frequency);
-        set_pwm_frequency(BUZZER_PIN_B, frequency);
-
-        // Ajusta o nível do PWM para modular o volume offset
-        pwm_set_gpio_level(BUZZER_PIN_A, sample + volume_offset);
-        pwm_set_gpio_level(BUZZER_PIN_B, sample + volume_offset);
-
-        sleep_us(DELAY_SAMPLE + delay_offset); // 1/SAMPLE_RATE * 1e6, delay em microsegundos do tempo das amostras, atraves do SAMPLE_RATE
-    }
-
-    // Coloca em um frequencia baixa e depois desativa o PWM ao final da reprodução
-    set_pwm_frequency(BUZZER_PIN_A, 1);
-    set_pwm_frequency(BUZZER_PIN_B, 1);
-    pwm_set_gpio_level(BUZZER_PIN_A, 0);
-    pwm_set_gpio_level(BUZZER_PIN_B, 0);
-    sleep_ms(100);
-    pwm_set_enabled(slice_num_A, false);
-    pwm_set_enabled(slice_num_B, false);
+    // Toca o slot selecionado direto da flash; sem gravação nele, toca a última gravação da RAM
+    uint32_t source_rate = recorded_rate;
+    if (flash_store_slot_length(current_slot) > 0)
+    {
+        audio_store_open(flash_store_slot_data(current_slot), flash_store_slot_length(current_slot),
+                         flash_store_slot_format(current_slot));
+        source_rate = flash_store_slot_rate(current_slot);
+    }
+    else
+    {
+        audio_store_begin_read();
+    }
+
+    // A velocidade entra na razão do reamostrador: a saída continua em playback_rate, ritmada pelo DMA
+    voice_set_source(source_rate * speed_num[speed_index], playback_rate * speed_den[speed_index]);
+    voice_reset(semitone_offset, effect_index, volume_offset, playback_rate);
+    if (!audio_playback_start(playback_rate, voice_read_store, play_done_handler))
+    {
+        printf("Erro: reproducao de audio ja em andamento.\n");
+        event_post(EVENT_AUDIO_DONE, STATE_PLAYING);
+    }
+}
+
+// Encerra a reprodução antes do fim do áudio
+void stop_playing()
+{
+    audio_playback_stop();
+}
+
+// Inicia o modo ao vivo: microfone -> efeitos no núcleo 1 -> buzzers
+void start_live()
+{
+    // No modo ao vivo entrada e saída andam na taxa de captura, sem reamostrar
+    uint32_t rate = capture_rates[capture_rate_index];
+    adc_scheduler_set_sample_rate(rate);
+    voice_reset(semitone_offset, effect_index, volume_offset, rate);
+    if (!audio_live_start(rate, voice_process_block))
+    {
+        printf("Erro: audio ja em uso.\n");
+        event_post(EVENT_AUDIO_DONE, STATE_LIVE);
+    }
+}
+
+// Encerra o modo ao vivo
+void stop_live()
+{
+    audio_live_stop();
 }
 
 // Callback para interrupção dos botões com debounce
+// Só publica o evento; a decisão do que fazer fica com o laço principal
 void buttons_callback(uint gpio, uint32_t events)
 {
     absolute_time_t now = get_absolute_time();
@@ -161,7 +352,7 @@ void buttons_callback(uint gpio, uint32_t events)
         // Verifica debounce para o botão de gravação
         if (absolute_time_diff_us(last_button_A_press, now) / 1000 > DEBOUNCE_DELAY_MS)
         {
-            system_state = STATE_RECORDING;
+            event_post(EVENT_BUTTON_A, 0);
             last_button_A_press = now;
         }
     }
@@ -171,7 +362,7 @@ void buttons_callback(uint gpio, uint32_t events)
         // Verifica debounce para o botão de reprodução
         if (absolute_time_diff_us(last_button_B_press, now) / 1000 > DEBOUNCE_DELAY_MS)
         {
-            system_state = STATE_PLAYING;
+            event_post(EVENT_BUTTON_B, 0);
             last_button_B_press = now;
         }
     }
@@ -181,27 +372,103 @@ void buttons_callback(uint gpio, uint32_t events)
         // Verifica debounce para o botão do Joystick
         if (absolute_time_diff_us(last_button_JOYSTICK_press, now) / 1000 > DEBOUNCE_DELAY_MS)
         {
-            if (system_state != STATE_MENU)
-            {
-                config_menu = false;
-                system_state = STATE_MENU;
-            }
-            else
-            {
-                system_state = STATE_INIT;
-            }
+            event_post(EVENT_BUTTON_JOYSTICK, 0);
             last_button_JOYSTICK_press = now;
         }
     }
 }
 
+// Timer dos quadros da visualização (IRQ do alarme)
+bool frame_timer_callback(repeating_timer_t *timer)
+{
+    if (!frame_pending)
+    {
+        frame_pending = event_post(EVENT_FRAME, 0);
+    }
+    return true;
+}
+
+// Timer de leitura do Joystick no menu (IRQ do alarme)
+bool menu_timer_callback(repeating_timer_t *timer)
+{
+    if (!menu_tick_pending)
+    {
+        menu_tick_pending = event_post(EVENT_MENU_TICK, 0);
+    }
+    return true;
+}
+
+// Caracteres chegando pela USB CDC (IRQ do USB); a leitura fica com o laço principal
+void usb_chars_callback(void *param)
+{
+    if (!usb_command_pending)
+    {
+        usb_command_pending = event_post(EVENT_USB_COMMAND, 0);
+    }
+}
+
+// Quadro novo na fila do streaming (contexto da IRQ do DMA); o envio fica com o laço principal
+void usb_stream_ready(void)
+{
+    if (!usb_stream_pending)
+    {
+        usb_stream_pending = event_post(EVENT_USB_STREAM, 0);
+    }
+}
+
+// Escreve um quadro direto no driver da USB CDC, sem a conversão de '\n' em "\r\n" do stdio
+// Se o computador não estiver lendo, espera no máximo o timeout do stdio_usb; a captura não espera
+void usb_stream_write(const uint8_t *data, uint length)
+{
+    stdio_usb.out_chars((const char *)data, length);
+}
+
+// Comandos de diagnóstico pela USB, um caractere cada:
+// 's' envia as estatísticas de tempo real (linhas JSON) e 'r' zera todas
+// 'c' transmite a captura, 'o' a saída da reprodução, 'a' as duas e 'x' para (quadros binários, ver stream_codec.h)
+void usb_command_service()
+{
+    int command;
+    while ((command = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        if (command == 's')
+        {
+            stats_dump();
+            printf("{\"descartes\":{\"ao_vivo\":%lu,\"eventos\":%lu,\"streaming\":%lu}}\n",
+                   (unsigned long)audio_live_dropped_blocks(), (unsigned long)event_queue_dropped(),
+                   (unsigned long)audio_stream_dropped());
+        }
+        else if (command == 'r')
+        {
+            stats_reset();
+        }
+        else if (command == 'c')
+        {
+            audio_stream_enable(1u << STREAM_SOURCE_CAPTURE);
+        }
+        else if (command == 'o')
+        {
+            audio_stream_enable(1u << STREAM_SOURCE_OUTPUT);
+        }
+        else if (command == 'a')
+        {
+            audio_stream_enable((1u << STREAM_SOURCE_CAPTURE) | (1u << STREAM_SOURCE_OUTPUT));
+        }
+        else if (command == 'x')
+        {
+            audio_stream_enable(0);
+        }
+    }
+}
+
+// Framebuffer persistente do display; só as páginas/colunas alteradas são enviadas pelo I2C
+uint8_t ssd[ssd1306_buffer_length];
+
 // Função para atualizar o display OLED com um conjunto de strings
-void put_string_ssd1306(struct render_area frame_area, char *text[], int size)
+void put_string_ssd1306(char *text[], int size)
 {
-    uint8_t ssd[ssd1306_buffer_length];
-    // Zera o buffer do display
+    // Zera o framebuffer (apenas na RAM; o display recebe só a diferença no final)
     memset(ssd, 0, ssd1306_buffer_length);
-    render_on_display(ssd, &frame_area);
 
     int y = 0;
     for (uint i = 0; i < size; i++)
@@ -209,31 +476,519 @@ void put_string_ssd1306(struct render_area frame_area, char *text[], int size)
         ssd1306_draw_string(ssd, 5, y, text[i], false);
         y += 8; // Incrementa a posição vertical para a próxima linha
     }
-    render_on_display(ssd, &frame_area);
+    ssd1306_flush_wait(); // Só espera se o envio anterior ainda estiver em andamento
+    render_changes_on_display_async(ssd, NULL);
 }
 
 // Função para atualizar o display OLED com um conjunto de strings, invertendo as cores das linhas
-void put_string_ssd1306_line_inverted(struct render_area frame_area, char *text[], int size, int lines_inverted)
+void put_string_ssd1306_line_inverted(char *text[], int size, int lines_inverted)
 {
-    uint8_t ssd[ssd1306_buffer_length];
-    // Zera o buffer do display
+    // Zera o framebuffer (apenas na RAM; o display recebe só a diferença no final)
     memset(ssd, 0, ssd1306_buffer_length);
-    render_on_display(ssd, &frame_area);
 
     int y = 0;
-    bool inverted = false;
     for (uint i = 0; i < size; i++)
     {
-
+        ssd1306_draw_string(ssd, 5, y, text[i], false);
         if (i == lines_inverted)
         {
-            inverted = true;
+            // Destaca a linha inteira invertendo a faixa por XOR
+            ssd1306_fill_rect(ssd, 0, y, ssd1306_width, 8, ssd1306_draw_xor);
         }
-        ssd1306_draw_string(ssd, 5, y, text[i], inverted);
-        inverted = false;
         y += 8; // Incrementa a posição vertical para a próxima linha
     }
-    render_on_display(ssd, &frame_area);
+    ssd1306_flush_wait(); // Só espera se o envio anterior ainda estiver em andamento
+    render_changes_on_display_async(ssd, NULL);
+}
+
+// Troca a tela de texto pela visualização do áudio em andamento
+void start_visualizer(const char *title)
+{
+    visualizer_reset();
+    visualizer_title = title;
+}
+
+// Desenha um quadro da visualização: título na primeira página e o gráfico nas outras sete
+// Se o envio anterior ainda não acabou, o quadro é pulado em vez de esperar, limitando o tempo de CPU
+void render_visualizer()
+{
+    if (ssd1306_flush_busy())
+    {
+        return;
+    }
+
+    memset(ssd, 0, ssd1306_page_height * ssd1306_width);
+    ssd1306_draw_text(ssd, 0, 0, visualizer_title, ssd1306_draw_set);
+    visualizer_render(ssd, ssd1306_page_height, ssd1306_height - ssd1306_page_height, visualizer_mode);
+    render_changes_on_display_async(ssd, NULL);
+}
+
+// Textos padrões para o display
+char *text_idle[] = {
+    "   Bem vindo   ",
+    "      ao       ",
+    " Mudaca de voz ",
+    "               ",
+    "Aperte o Botao ",
+    " A      Gravar ",
+    " B       Tocar ",
+    "Joystick   Menu"};
+
+// Variaveis para colocar o valor do inteiro no texto do display
+char change_slot[16] = "";
+char change_pitch[16] = "";
+char change_volume[16] = "";
+char change_speed[16] = "";
+char change_visual[16] = "";
+char change_rate[16] = "";
+char change_effect[16] = "";
+char change_trigger[16] = "";
+
+// Linha selecionada no menu (1 a MENU_LINES) e controle de repetição do Joystick
+int menu_line = 2;
+uint menu_hold_ticks = 0;
+
+// Atualiza os textos com os valores atuais e desenha o menu com a linha selecionada invertida
+void show_menu()
+{
+    sprintf(change_slot, "Slot          %d", current_slot + 1);
+    sprintf(change_pitch, "Tom      %+dst", semitone_offset);
+    sprintf(change_volume, "Volume      %d", volume_offset);
+    uint speed = 100 * speed_num[speed_index] / speed_den[speed_index];
+    sprintf(change_speed, "Veloc.    x%u.%02u", speed / 100, speed % 100);
+    sprintf(change_visual, "Visual %s", visualizer_mode == VISUALIZER_WAVEFORM ? "    Onda" : "Espectro");
+    sprintf(change_rate, "Taxa grav.%2ukHz", (uint)(capture_rates[capture_rate_index] / 1000));
+    sprintf(change_effect, "Efeito %8s", effects_chain_name(effect_index));
+    sprintf(change_trigger, "Gravar %s", record_on_voice ? "     Voz" : "   Botao");
+    char *text_lines[MENU_LINES] = {
+        change_slot,
+        change_pitch,
+        change_volume,
+        change_speed,
+        "Modo ao vivo   ",
+        change_visual,
+        change_rate,
+        change_effect,
+        change_trigger};
+
+    // O título fica fixo e as linhas rolam para a selecionada estar sempre visível
+    int first = menu_line > MENU_VISIBLE_LINES ? menu_line - MENU_VISIBLE_LINES + 1 : 1;
+    char *text_menu[MENU_VISIBLE_LINES + 1] = {"Para Modificar "};
+    for (int i = 0; i < MENU_VISIBLE_LINES; i++)
+    {
+        text_menu[i + 1] = text_lines[first - 1 + i];
+    }
+    put_string_ssd1306_line_inverted(text_menu, count_of(text_menu), menu_line - first + 1);
+}
+
+// Liga ou desliga os timers periódicos conforme o estado
+void set_timers(bool frame, bool menu)
+{
+    if (frame && !frame_timer_active)
+    {
+        frame_timer_active = add_repeating_timer_ms(VISUALIZER_FRAME_MS, frame_timer_callback, NULL, &frame_timer);
+    }
+    else if (!frame && frame_timer_active)
+    {
+        cancel_repeating_timer(&frame_timer);
+        frame_timer_active = false;
+    }
+
+    if (menu && !menu_timer_active)
+    {
+        menu_hold_ticks = 0;
+        menu_timer_active = add_repeating_timer_ms(MENU_TICK_MS, menu_timer_callback, NULL, &menu_timer);
+    }
+    else if (!menu && menu_timer_active)
+    {
+        cancel_repeating_timer(&menu_timer);
+        menu_timer_active = false;
+    }
+}
+
+// Troca de estado: liga o que o novo estado usa e desenha a tela dele
+void enter_state(system_state_t state)
+{
+    system_state = state;
+
+    switch (state)
+    {
+    case STATE_RECORDING:
+    {
+        set_timers(true, false);
+        start_visualizer(record_on_voice ? "Aguardando voz - A sai" : "Gravando - A para parar");
+        record_audio(); // Inicia a gravação via ADC + DMA, sem bloquear
+        break;
+    }
+    case STATE_PLAYING:
+    {
+        set_timers(true, false);
+        start_visualizer("Tocando - B para parar");
+        play_audio(); // Inicia a reprodução do áudio armazenado, sem bloquear
+        break;
+    }
+    case STATE_LIVE:
+    {
+        set_timers(true, false);
+        start_visualizer("Ao vivo - botao sai");
+        start_live();
+        break;
+    }
+    case STATE_MENU:
+    {
+        set_timers(false, true);
+        config_menu = false;
+        menu_line = 2;
+        show_menu();
+        break;
+    }
+    case STATE_IDLE:
+    default:
+    {
+        set_timers(false, false);
+        flash_save_service(); // Fecha o slot da gravação que acabou de terminar
+        put_string_ssd1306(text_idle, count_of(text_idle));
+        event_post(EVENT_FLASH_SERVICE, 0); // Com o áudio parado, volta a apagar a flash à frente
+        break;
+    }
+    }
+}
+
+// Leitura do Joystick no menu: age quando o eixo inclina e repete enquanto estiver segurado
+void menu_joystick_tick()
+{
+    // Direção de cada eixo, já filtrada e com histerese pelo rodízio do ADC (sem leitura bloqueante)
+    int joystick_x = joystick_direction_x();
+    int joystick_y = joystick_direction_y();
+
+    if (joystick_x == 0 && joystick_y == 0)
+    {
+        menu_hold_ticks = 0;
+        return;
+    }
+    if (menu_hold_ticks++ % MENU_REPEAT_TICKS != 0)
+    {
+        return;
+    }
+
+    bool update_display = false;
+
+    // Verificar se colocou o Joystick para cima
+    if (joystick_y > 0)
+    {
+        // Verifica se esta com a opção de configurar o menu desativado
+        if (!config_menu)
+        {
+            // Limite para não passar para as linhas acima do 1
+            if (menu_line > 1)
+            {
+                menu_line -= 1;
+                update_display = true;
+            }
+        }
+        // Verifica se esta com a opção de configurar o menu ativado
+        else
+        {
+            // Verifica se esta na primeira linha, que vai trocar o slot da flash
+            if (menu_line == 1)
+            {
+                current_slot = (current_slot + 1) % FLASH_STORE_SLOTS;
+                update_display = true;
+            }
+            // Verifica se esta na segunda linha, que vai alterar o tom em semitons
+            else if (menu_line == 2)
+            {
+                if (semitone_offset < PITCH_SHIFT_MAX_SEMITONES)
+                {
+                    semitone_offset += 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na terceira linha, que vai alterar o duty cycle do PWM no caso volume
+            else if (menu_line == 3)
+            {
+                if (volume_offset < 100)
+                {
+                    volume_offset += 10;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na quarta linha, que vai acelerar a reprodução do audio
+            else if (menu_line == 4)
+            {
+                if (speed_index + 1 < count_of(speed_num))
+                {
+                    speed_index += 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na sexta linha, que vai alternar a visualização
+            else if (menu_line == 6)
+            {
+                visualizer_mode = visualizer_mode == VISUALIZER_WAVEFORM ? VISUALIZER_SPECTRUM : VISUALIZER_WAVEFORM;
+                update_display = true;
+            }
+            // Verifica se esta na sétima linha, que vai aumentar a taxa de gravação (até o limite do ADC)
+            else if (menu_line == 7)
+            {
+                if (capture_rate_index + 1 < count_of(capture_rates) &&
+                    capture_rates[capture_rate_index + 1] <= ADC_SCHEDULER_MAX_RATE)
+                {
+                    capture_rate_index += 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na oitava linha, que vai trocar a cadeia de efeitos
+            else if (menu_line == 8)
+            {
+                effect_index = (effect_index + 1) % effects_chain_count();
+                update_display = true;
+            }
+            // Verifica se esta na nona linha, que vai alternar o disparo da gravação (botão ou voz)
+            else if (menu_line == 9)
+            {
+                record_on_voice = !record_on_voice;
+                update_display = true;
+            }
+        }
+    }
+    // Verificar se colocou o Joystick para baixo
+    else if (joystick_y < 0)
+    {
+        // Verifica se esta com a opção de configurar o menu desativado
+        if (!config_menu)
+        {
+            // Limite para não passar da última linha
+            if (menu_line < MENU_LINES)
+            {
+                menu_line += 1;
+                update_display = true;
+            }
+        }
+        // Verifica se esta com a opção de configurar o menu ativado
+        else
+        {
+            // Verifica se esta na primeira linha, que vai trocar o slot da flash
+            if (menu_line == 1)
+            {
+                current_slot = (current_slot + FLASH_STORE_SLOTS - 1) % FLASH_STORE_SLOTS;
+                update_display = true;
+            }
+            // Verifica se esta na segunda linha, que vai alterar o tom em semitons
+            else if (menu_line == 2)
+            {
+                if (semitone_offset > -PITCH_SHIFT_MAX_SEMITONES)
+                {
+                    semitone_offset -= 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na terceira linha, que vai alterar o duty cycle do PWM no caso volume
+            else if (menu_line == 3)
+            {
+                if (volume_offset > 0)
+                {
+                    volume_offset -= 10;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na quarta linha, que vai desacelerar a reprodução do audio
+            else if (menu_line == 4)
+            {
+                if (speed_index > 0)
+                {
+                    speed_index -= 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na sexta linha, que vai alternar a visualização
+            else if (menu_line == 6)
+            {
+                visualizer_mode = visualizer_mode == VISUALIZER_WAVEFORM ? VISUALIZER_SPECTRUM : VISUALIZER_WAVEFORM;
+                update_display = true;
+            }
+            // Verifica se esta na sétima linha, que vai diminuir a taxa de gravação
+            else if (menu_line == 7)
+            {
+                if (capture_rate_index > 0)
+                {
+                    capture_rate_index -= 1;
+                    update_display = true;
+                }
+            }
+            // Verifica se esta na oitava linha, que vai trocar a cadeia de efeitos
+            else if (menu_line == 8)
+            {
+                effect_index = (effect_index + effects_chain_count() - 1) % effects_chain_count();
+                update_display = true;
+            }
+            // Verifica se esta na nona linha, que vai alternar o disparo da gravação (botão ou voz)
+            else if (menu_line == 9)
+            {
+                record_on_voice = !record_on_voice;
+                update_display = true;
+            }
+        }
+    }
+
+    // Verificar se colocou o Joystick para esquerda e desabilita alterar as variaveis de offset
+    if (joystick_x < 0)
+    {
+        config_menu = false;
+    }
+    // Verificar se colocou o Joystick para direita e habilita alterar as variaveis de offset
+    else if (joystick_x > 0)
+    {
+        // Na linha do modo ao vivo, ir para a direita já entra no modo
+        if (menu_line == 5)
+        {
+            enter_state(STATE_LIVE);
+            return;
+        }
+        config_menu = true;
+    }
+
+    // Verifica se atualiza o display
+    if (update_display)
+    {
+        show_menu();
+    }
+}
+
+// Máquina de estados: cada evento é tratado conforme o estado atual
+void handle_event(const event_t *event)
+{
+    switch (event->type)
+    {
+    case EVENT_BUTTON_A:
+    {
+        // No modo ao vivo qualquer botão volta para a tela inicial
+        if (system_state == STATE_LIVE)
+        {
+            stop_live();
+            enter_state(STATE_IDLE);
+        }
+        // Com a gravação em andamento o Botão A encerra a gravação
+        else if (system_state == STATE_RECORDING)
+        {
+            stop_recording();
+            enter_state(STATE_IDLE);
+        }
+        else if (!audio_playback_is_running())
+        {
+            enter_state(STATE_RECORDING);
+        }
+        break;
+    }
+    case EVENT_BUTTON_B:
+    {
+        if (system_state == STATE_LIVE)
+        {
+            stop_live();
+            enter_state(STATE_IDLE);
+        }
+        // Com a reprodução em andamento o Botão B encerra a reprodução (mesmo com o menu aberto)
+        else if (audio_playback_is_running())
+        {
+            stop_playing();
+            enter_state(STATE_IDLE);
+        }
+        else if (system_state != STATE_RECORDING)
+        {
+            enter_state(STATE_PLAYING);
+        }
+        break;
+    }
+    case EVENT_BUTTON_JOYSTICK:
+    {
+        if (system_state == STATE_LIVE)
+        {
+            stop_live();
+            enter_state(STATE_IDLE);
+        }
+        else if (system_state == STATE_MENU)
+        {
+            enter_state(STATE_IDLE);
+        }
+        // O menu não abre durante a gravação: a tela fica com a visualização e a cópia para a flash
+        else if (system_state != STATE_RECORDING)
+        {
+            enter_state(STATE_MENU);
+        }
+        break;
+    }
+    case EVENT_AUDIO_DONE:
+    {
+        // Só vale para o estado que gerou o evento: um fim atrasado não derruba um áudio novo,
+        // e com o menu aberto a reprodução pode acabar sem tirar o usuário do menu
+        if (event->data == system_state)
+        {
+            enter_state(STATE_IDLE);
+        }
+        break;
+    }
+    case EVENT_FRAME:
+    {
+        frame_pending = false;
+        flash_save_service(); // Copia para a flash a parte da gravação que já está completa
+        if (system_state == STATE_RECORDING || system_state == STATE_PLAYING || system_state == STATE_LIVE)
+        {
+            // O Joystick continua ativo com o áudio rodando: para os lados alterna a visualização
+            int joystick_x = joystick_direction_x();
+            if (joystick_x != 0 && joystick_x != visualizer_joystick_x)
+            {
+                visualizer_mode = visualizer_mode == VISUALIZER_WAVEFORM ? VISUALIZER_SPECTRUM : VISUALIZER_WAVEFORM;
+            }
+            visualizer_joystick_x = joystick_x;
+            render_visualizer();
+        }
+        break;
+    }
+    case EVENT_VOICE_DETECTED:
+    {
+        if (system_state == STATE_RECORDING)
+        {
+            visualizer_title = "Gravando voz - A para";
+        }
+        break;
+    }
+    case EVENT_MENU_TICK:
+    {
+        menu_tick_pending = false;
+        if (system_state == STATE_MENU)
+        {
+            menu_joystick_tick();
+        }
+        break;
+    }
+    case EVENT_USB_COMMAND:
+    {
+        usb_command_pending = false;
+        usb_command_service();
+        break;
+    }
+    case EVENT_USB_STREAM:
+    {
+        // Esvazia a fila do streaming; o que chegar durante o envio publica um novo evento
+        usb_stream_pending = false;
+        while (audio_stream_service())
+        {
+        }
+        break;
+    }
+    case EVENT_FLASH_SERVICE:
+    {
+        // Um setor por evento, para os botões não esperarem a janela inteira ser apagada
+        if (system_state == STATE_IDLE || system_state == STATE_MENU)
+        {
+            if (flash_save_service())
+            {
+                event_post(EVENT_FLASH_SERVICE, 0);
+            }
+        }
+        break;
+    }
+    }
 }
 
 int main()
@@ -241,6 +996,15 @@ int main()
     // Inicializa STDIO e espera conexão, se necessário
     stdio_init_all();
 
+    // Fila de eventos do laço principal (antes de qualquer IRQ publicar nela)
+    event_queue_init();
+
+    // Comandos de diagnóstico pela USB chegam como eventos
+    stdio_set_chars_available_callback(usb_chars_callback, NULL);
+
+    // Streaming de áudio pela USB, desligado até chegar um comando
+    audio_stream_init(usb_stream_write, usb_stream_ready);
+
     // Configura os botões com pull-up e define as interrupções
     gpio_init(BUTTON_A);
     gpio_init(BUTTON_B);
@@ -252,7 +1016,6 @@ int main()
     gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &buttons_callback);
 
     // Configura os controles do joystick
-    adc_init();
     adc_gpio_init(JOYSTICK_Y);
     adc_gpio_init(JOYSTICK_X);
     gpio_init(JOYSTICK_BUTTON);             // Inicializa o pino do botão
@@ -263,27 +1026,26 @@ int main()
     // Inicializa e configura o ADC do MIC
     adc_gpio_init(MIC_PIN);
 
-    // Configura o FIFO do ADC:
-    // - FIFO habilitado
-    // - Requisição de DMA habilitada
-    // - DREQ quando há 1 amostra disponível
-    // - Bit de erro desabilitado
-    // - **Realiza shift dos dados**, mantendo 8 bits dos 12 bits originais
-    adc_fifo_setup(
-        true,  // FIFO habilitado
-        true,  // DMA habilitado
-        1,     // DREQ com 1 amostra
-        false, // Bit de erro desabilitado
-        true   // Realiza shift para 8 bits (mantém 8 bits)
-    );
-
-    // Calcula o divisor do clock do ADC para atingir a taxa de amostragem desejada
-    uint32_t div = clock_get_hz(clk_adc) / SAMPLE_RATE;
-    adc_set_clkdiv(div);
-
-    // Configura o pino do buzzer para função PWM
-    gpio_set_function(BUZZER_PIN_A, GPIO_FUNC_PWM);
-    gpio_set_function(BUZZER_PIN_B, GPIO_FUNC_PWM);
+    // ADC em rodízio contínuo (Joystick e microfone) com DMA, cada canal na taxa de captura escolhida
+    adc_scheduler_init(capture_rates[capture_rate_index]);
+
+    // Entrega a memória de gravação ao audio_store
+    audio_store_init(audio_buffer, BUFFER_SIZE);
+
+    // Monta as gravações guardadas na flash (antes de ligar o núcleo 1)
+    const flash_store_ops_t *flash_ops = flash_store_pico_ops();
+    flash_ready = flash_ops && flash_store_mount(flash_ops, BUFFER_SIZE);
+
+    // Consumidores do rodízio: microfone em taxa cheia e Joystick dizimado e filtrado
+    audio_capture_init(MIC_CHANNEL);
+    joystick_init(JOYSTICK_X_CHANNEL, JOYSTICK_Y_CHANNEL);
+    adc_scheduler_start();
+
+    // Passa os pinos dos buzzers para o PIO e reserva os canais DMA da reprodução
+    audio_playback_init(BUZZER_PIN_A, BUZZER_PIN_B);
+
+    // Núcleo 1 fica aguardando os blocos do modo ao vivo
+    audio_live_init();
 
     // Inicializa o I2C para o display SSD1306
     i2c_init(I2C_PORT, ssd1306_i2c_clock * 1000);
@@ -294,248 +1056,17 @@ int main()
 
     // Inicializa o display OLED
     ssd1306_init();
-    // Define a área de renderização para o display
-    struct render_area frame_area = {
-        .start_column = 0,
-        .end_column = ssd1306_width - 1,
-        .start_page = 0,
-        .end_page = ssd1306_n_pages - 1};
-    calculate_render_area_buffer_length(&frame_area);
-
-    // Textos padrões para o display
-    char *text_idle[] = {
-        "   Bem vindo   ",
-        "      ao       ",
-        " Mudaca de voz ",
-        "               ",
-        "Aperte o Botao ",
-        " A      Gravar ",
-        " B       Tocar ",
-        "Joystick   Menu"};
-
-    char *text_record[] = {
-        "Comecou Gravar ",
-        "               ",
-        "    Aguarde    ",
-        " a finalizacao ",
-        "               ",
-        " Gravacao e de ",
-        "  5 segundos   ",
-        "               "};
-
-    char *text_play[] = {
-        "Comecou a Tocar",
-        "               ",
-        "    Aguarde    ",
-        " a finalizacao ",
-        "               ",
-        "Reproducao e de",
-        "  5 segundos   ",
-        "               "};
-
-    // Variaveis para colocar o valor do inteiro no texto do display
-    char change_frequency[16] = "";
-    char change_volume[16] = "";
-    char change_delay[16] = "";
-    sprintf(change_frequency, "Freq     %dHz", frequency_offset);
-    sprintf(change_volume, "Volume      %d", volume_offset);
-    sprintf(change_delay, "Atraso    %dus", delay_offset);
+    ssd1306_invalidate(); // A RAM do display começa com lixo: o primeiro envio é completo
 
-    char *text_menu[] = {
-        "Para Modificar ",
-        "               ",
-        change_frequency,
-        change_volume,
-        change_delay,
-        "               ",
-        "Voltar aperter ",
-        "  no Joystick  "};
-
-    // Variavel de atualização do texto do display
-    bool update_display = false;
+    // Mostra a tela inicial e segue a máquina de estados pelos eventos
+    enter_state(STATE_IDLE);
 
-    // Loop principal utilizando a state machine
+    // Loop principal: dorme em WFI até chegar um evento
     while (true)
     {
-        switch (system_state)
-        {
-        case STATE_RECORDING:
-        {
-            put_string_ssd1306(frame_area, text_record, count_of(text_record));
-            record_audio();            // Realiza a gravação via ADC + DMA
-            system_state = STATE_INIT; // Retorna ao estado inicial após gravação
-            break;
-        }
-        case STATE_PLAYING:
-        {
-            put_string_ssd1306(frame_area, text_play, count_of(text_play));
-            play_audio();              // Reproduz o áudio armazenado
-            system_state = STATE_INIT; // Retorna ao estado inicial após reprodução
-            break;
-        }
-        case STATE_INIT:
-        {
-            // Em estado inicial, exibe a tela inicial
-            // Exibe mensagem inicial no OLED
-            put_string_ssd1306(frame_area, text_idle, count_of(text_idle));
-            system_state = STATE_IDLE; // Retorna ao estado ocioso após reprodução
-            break;
-        }
-        case STATE_MENU:
-        {
-            // Coloca o texto do Menu no display
-            int a = 2;
-            put_string_ssd1306_line_inverted(frame_area, text_menu, count_of(text_menu), a);
-
-            // Enquanto estiver no estado STATE_MENU, vai ficar no while
-            while (system_state == STATE_MENU)
-            {
-                // Pegando os valores dos eixos X e Y do Joystick
-                adc_select_input(JOYSTICK_Y_CHANNEL);
-                uint adc_y_raw = adc_read();
-                adc_select_input(JOYSTICK_X_CHANNEL);
-                uint adc_x_raw = adc_read();
-
-                // Verificar se colocou o Joystick para cima
-                if (adc_y_raw == 4081)
-                {
-                    // Verifica se esta com a opção de configurar o menu desativado
-                    if (!config_menu)
-                    {
-                        // Limite para não passar para as linhas acima do 2
-                        if (a > 2)
-                        {
-                            a -= 1;
-                            update_display = true;
-                        }
-                    }
-                    // Verifica se esta com a opção de configurar o menu ativado
-                    else
-                    {
-                        // Verifica se esta na segunda linha, que vai alterar a frequencia do PWM
-                        if (a == 2)
-                        {
-                            frequency_offset += 100;
-                            update_display = true;
-                        }
-                        // Verifica se esta na terceira linha, que vai alterar o duty cycle do PWM no caso volume
-                        else if (a == 3)
-                        {
-                            if (volume_offset < 100)
-                            {
-                                volume_offset += 10;
-                                update_display = true;
-                            }
-                        }
-                        // Verifica se esta na quarta linha, que vai alterar no delay das amostras da reprodução do audio
-                        else if (a == 4)
-                        {
-                            delay_offset += 5;
-                            update_display = true;
-                        }
-                    }
-                    // Verifica se atualiza o display
-                    if (update_display)
-                    {
-                        sprintf(change_frequency, "Freq     %dHz", frequency_offset);
-                        sprintf(change_volume, "Volume      %d", volume_offset);
-                        sprintf(change_delay, "Atraso    %dus", delay_offset);
-                        char *text_menu[] = {
-                            "Para Modificar ",
-                            "               ",
-                            change_frequency,
-                            change_volume,
-                            change_delay,
-                            "               ",
-                            "Voltar aperter ",
-                            "  no Joystick  "};
-                        put_string_ssd1306_line_inverted(frame_area, text_menu, count_of(text_menu), a);
-                        update_display = false;
-                    }
-                }
-                // Verificar se colocou o Joystick para baixo
-                else if (adc_y_raw == 16)
-                {
-                    // Verifica se esta com a opção de configurar o menu desativado
-                    if (!config_menu)
-                    {
-                        // Limite para não passar para as linhas abaixo do 4
-                        if (a < 4)
-                        {
-                            a += 1;
-                            update_display = true;
-                        }
-                    }
-                    // Verifica se esta com a opção de configurar o menu ativado
-                    else
-                    {
-                        // Verifica se esta na segunda linha, que vai alterar a frequencia do PWM
-                        if (a == 2)
-                        {
-                            frequency_offset -= 100;
-                            update_display = true;
-                        }
-                        // Verifica se esta na terceira linha, que vai alterar o duty cycle do PWM no caso volume
-                        else if (a == 3)
-                        {
-                            if (volume_offset > 0)
-                            {
-                                volume_offset -= 10;
-                                update_display = true;
-                            }
-                        }
-                        // Verifica se esta na quarta linha, que vai alterar no delay das amostras da reprodução do audio
-                        else if (a == 4)
-                        {
-                            if (abs(delay_offset) < DELAY_SAMPLE)
-                            {
-                                delay_offset -= 5;
-                                update_display = true;
-                            }
-                        }
-                    }
-                    // Verifica se atualiza o display
-                    if (update_display)
-                    {
-                        sprintf(change_frequency, "Freq     %dHz", frequency_offset);
-                        sprintf(change_volume, "Volume      %d", volume_offset);
-                        sprintf(change_delay, "Atraso    %dus", delay_offset);
-                        char *text_menu[] = {
-                            "Para Modificar ",
-                            "               ",
-                            change_frequency,
-                            change_volume,
-                            change_delay,
-                            "               ",
-                            "Voltar aperter ",
-                            "  no Joystick  "};
-                        put_string_ssd1306_line_inverted(frame_area, text_menu, count_of(text_menu), a);
-                        update_display = false;
-                    }
-                }
-
-                // Verificar se colocou o Joystick para esquerda e desabilita alterar as variaveis de offset
-                if (adc_x_raw == 16)
-                {
-                    config_menu = false;
-                }
-                // Verificar se colocou o Joystick para direita e habilita alterar as variaveis de offset
-                else if (adc_x_raw == 4081)
-                {
-                    config_menu = true;
-                }
-                sleep_ms(200);
-            }
-            break;
-        }
-        case STATE_IDLE:
-        default:
-        {
-            break;
-        }
-        }
-        // Loop com pequeno atraso
-        sleep_ms(100);
+        event_t event;
+        event_wait(&event);
+        handle_event(&event);
     }
     return 0;
 }
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Gera resampler_table.h: as tabelas Q15 do projeto dos filtros do reamostrador (inc/resampler.c).
+
+O filtro de cada fase é um seno cardinal com janela de Blackman. As duas partes vêm prontas daqui:
+  - seno cardinal protótipo sin(pi u)/(pi u), amostrado de 1/64 em 1/64 em u; o corte de cada razão
+    escala o argumento (u = corte * t) e o firmware interpola linearmente entre as amostras
+  - janela de Blackman amostrada exatamente nas posições que os taps usam (t em passos de 1/fases)
+Assim o firmware monta as fases em ponto fixo, sem trigonometria nem ponto flutuante.
+
+Uso: resampler_table_gen.py <saida.h>
+"""
+
+import math
+import sys
+
+TAPS = 16         # RESAMPLER_TAPS
+PHASE_BITS = 5    # RESAMPLER_PHASE_BITS
+CUTOFF = 0.85     # Corte em fração da menor das duas frequências de Nyquist
+SINC_BITS = 6     # Passo de 1/64 no argumento do seno cardinal
+
+HALF = TAPS // 2
+PHASES = 1 << PHASE_BITS
+
+
+def q15(value):
+    return max(-32768, min(32767, round(value * 32767)))
+
+
+def c_values(values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(str(v) for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+
+    # O maior argumento é o corte máximo vezes meio filtro; +2 para a interpolação no último intervalo
+    sinc_count = math.ceil(CUTOFF * HALF * (1 << SINC_BITS)) + 2
+    sinc = []
+    for i in range(sinc_count):
+        u = i / (1 << SINC_BITS)
+        sinc.append(q15(1.0 if u == 0 else math.sin(math.pi * u) / (math.pi * u)))
+
+    window = []
+    for i in range(HALF * PHASES + 1):
+        t = i / PHASES
+        window.append(q15(0.42 + 0.5 * math.cos(math.pi * t / HALF) + 0.08 * math.cos(2 * math.pi * t / HALF)))
+
+    out = f"""// Gerado por tools/resampler_table_gen.py; não editar à mão
+
+#ifndef resampler_table_inc_h
+#define resampler_table_inc_h
+
+#define RESAMPLER_TABLE_TAPS {TAPS}
+#define RESAMPLER_TABLE_PHASE_BITS {PHASE_BITS}
+#define RESAMPLER_CUTOFF_Q15 {q15(CUTOFF)} // Corte em fração da menor Nyquist ({CUTOFF})
+#define RESAMPLER_SINC_BITS {SINC_BITS} // Passo de 1/{1 << SINC_BITS} no argumento do seno cardinal
+#define RESAMPLER_SINC_COUNT {sinc_count}
+
+// sin(pi u)/(pi u) em Q15, para u = i / {1 << SINC_BITS}
+static const int16_t resampler_sinc[RESAMPLER_SINC_COUNT] = {{
+{c_values(sinc)}
+}};
+
+// Janela de Blackman em Q15 para |t| = i / {PHASES} taps do centro (zero em |t| = {HALF})
+static const int16_t resampler_window[{len(window)}] = {{
+{c_values(window)}
+}};
+
+#endif
+"""
+    with open(sys.argv[1], 'w', encoding='utf-8') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main()
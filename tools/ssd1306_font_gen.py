@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Gera ssd1306_font.h a partir da descrição em texto da fonte (inc/ssd1306_font.txt).
+
+O atlas guarda só as colunas usadas por cada glifo (um byte por coluna, bit 0 no topo),
+concatenadas. Cada glifo tem só o byte baixo do seu deslocamento no atlas: o atlas cabe em
+512 bytes e os deslocamentos crescem, então o nono bit vale 1 a partir de um único glifo
+(ssd1306_font_high_from). A largura é a diferença para o deslocamento do glifo seguinte,
+e uma entrada extra no fim marca o fim do atlas.
+
+Uso: ssd1306_font_gen.py <entrada.txt> <saida.h>
+"""
+
+import sys
+
+FIRST = 0x20
+LAST = 0x7E
+HEIGHT = 8
+FALLBACK = '?'
+
+
+def parse(path):
+    glyphs = {}
+    name = None
+    rows = []
+
+    def close():
+        if name is None:
+            return
+        if len(rows) != HEIGHT:
+            sys.exit(f"{path}: glifo {name!r} tem {len(rows)} linhas, esperado {HEIGHT}")
+        if len(set(len(r) for r in rows)) != 1:
+            sys.exit(f"{path}: glifo {name!r} tem linhas de larguras diferentes")
+        glyphs[name] = rows
+
+    with open(path, encoding='utf-8') as f:
+        for number, line in enumerate(f, 1):
+            line = line.rstrip('\n')
+            if not line or line.startswith('#') and name is None:
+                continue
+            if line.startswith('= '):
+                close()
+                name = ' ' if line[2:] == 'space' else line[2:]
+                if len(name) != 1:
+                    sys.exit(f"{path}:{number}: nome de glifo inválido {name!r}")
+                rows = []
+                continue
+            if set(line) - set('#.'):
+                sys.exit(f"{path}:{number}: caractere inválido na linha {line!r}")
+            rows.append(line)
+    close()
+
+    missing = [chr(c) for c in range(FIRST, LAST + 1) if chr(c) not in glyphs]
+    if missing:
+        sys.exit(f"{path}: faltam glifos para {''.join(missing)!r}")
+    return glyphs
+
+
+def columns(rows):
+    width = len(rows[0])
+    return [sum(1 << y for y in range(HEIGHT) if rows[y][x] == '#') for x in range(width)]
+
+
+def c_bytes(values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(f'0x{v:02x}' for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    glyphs = parse(sys.argv[1])
+
+    atlas = []
+    offsets = []
+    widths = []
+    for code in range(FIRST, LAST + 1):
+        cols = columns(glyphs[chr(code)])
+        offsets.append(len(atlas))
+        widths.append(len(cols))
+        atlas.extend(cols)
+    offsets.append(len(atlas))  # Fim do último glifo
+
+    if len(atlas) >= 512:
+        sys.exit(f"atlas com {len(atlas)} bytes não cabe em deslocamentos de 9 bits")
+    high_from = next((g for g, offset in enumerate(offsets) if offset >= 256), len(offsets))
+    total = len(atlas) + len(offsets)
+
+    out = f"""// Gerado por tools/ssd1306_font_gen.py a partir de inc/ssd1306_font.txt; não editar à mão
+
+#ifndef ssd1306_font_inc_h
+#define ssd1306_font_inc_h
+
+#define ssd1306_font_height {HEIGHT} // Altura da célula do glifo (uma página)
+#define ssd1306_font_max_width {max(widths)} // Maior largura de glifo
+#define ssd1306_font_glyphs {len(widths)} // Glifos no atlas (ASCII 0x{FIRST:02X} a 0x{LAST:02X})
+#define ssd1306_font_first 0x{FIRST:02X} // Primeiro caractere com glifo
+#define ssd1306_font_last 0x{LAST:02X} // Último caractere com glifo
+#define ssd1306_font_fallback '{FALLBACK}' // Glifo dos caracteres fora da faixa
+#define ssd1306_font_high_from {high_from} // Primeiro glifo com deslocamento >= 256
+
+// {total} bytes de tabelas: {len(atlas)} do atlas + {len(offsets)} de deslocamentos
+// Colunas de todos os glifos, concatenadas (bit 0 = linha de cima)
+static const uint8_t ssd1306_font_atlas[{len(atlas)}] = {{
+{c_bytes(atlas)}
+}};
+
+// Byte baixo da posição da primeira coluna de cada glifo no atlas, mais o fim do atlas
+static const uint8_t ssd1306_font_offset[{len(offsets)}] = {{
+{chr(10).join('    ' + ', '.join(str(v & 0xFF) for v in offsets[i:i + 16]) + ',' for i in range(0, len(offsets), 16))}
+}};
+
+#endif
+"""
+    with open(sys.argv[2], 'w', encoding='utf-8') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main()